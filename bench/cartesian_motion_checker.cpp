@@ -0,0 +1,33 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <benchmark/benchmark.h>
+
+#include <research_interface/robot/cartesian_motion_checker.h>
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+void BM_CheckCartesianMotion(benchmark::State& state) {
+  const robot::CartesianMotionChecker checker;
+  robot::RobotState robot_state{};
+  robot_state.motion_generator_mode = robot::MotionGeneratorMode::kCartesianPosition;
+  robot_state.O_T_EE_c = {{1, 0, 0, 0, 0, -1, 0, 0, 0, 0, -1, 0, 0.3, 0, 0.5, 1}};
+  robot_state.elbow = {{0.0, -1.0}};
+  robot::MotionGeneratorCommand command{};
+  command.O_T_EE_c = robot_state.O_T_EE_c;
+  command.elbow_c = robot_state.elbow;
+  command.valid_elbow = true;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(command);
+    benchmark::DoNotOptimize(robot_state);
+    benchmark::DoNotOptimize(checker.check(command, robot_state));
+  }
+}
+
+BENCHMARK(BM_CheckCartesianMotion);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
@@ -0,0 +1,94 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <array>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <research_interface/codec.h>
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/service_types.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+// What getInstance() did before bitCast: fast, but undefined behavior under strict aliasing.
+template <typename T>
+void BM_DecodeReinterpretCast(benchmark::State& state) {
+  std::array<uint8_t, sizeof(T)> payload{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(payload);
+    const T instance = *reinterpret_cast<const T*>(payload.data());
+    benchmark::DoNotOptimize(instance);
+  }
+}
+
+template <typename T>
+void BM_DecodeBitCast(benchmark::State& state) {
+  std::array<uint8_t, sizeof(T)> payload{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(payload);
+    const T instance = bitCast<T>(payload);
+    benchmark::DoNotOptimize(instance);
+  }
+}
+
+template <typename T>
+void BM_DecodeLoadUnaligned(benchmark::State& state) {
+  std::array<uint8_t, sizeof(T) + 1> payload{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(payload);
+    const T instance = loadUnaligned<T>(payload.data() + 1);
+    benchmark::DoNotOptimize(instance);
+  }
+}
+
+// Single-field reads of a decoded response, see the trade-off described at bitCast().
+void BM_ReadFieldReinterpretCast(benchmark::State& state) {
+  using Response = robot::GetCartesianLimit::Response;
+  std::array<uint8_t, sizeof(Response)> payload{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(payload);
+    const double value = reinterpret_cast<const Response*>(payload.data())->object_frame[13];
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+void BM_ReadFieldBitCast(benchmark::State& state) {
+  using Response = robot::GetCartesianLimit::Response;
+  std::array<uint8_t, sizeof(Response)> payload{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(payload);
+    const double value = bitCast<Response>(payload).object_frame[13];
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+void BM_ReadFieldLoadField(benchmark::State& state) {
+  using Response = robot::GetCartesianLimit::Response;
+  std::array<uint8_t, sizeof(Response)> payload{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(payload);
+    const double value = loadField<Response>(payload.data(), &Response::object_frame)[13];
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_DecodeReinterpretCast, robot::SetCollisionBehavior::Request);
+BENCHMARK_TEMPLATE(BM_DecodeBitCast, robot::SetCollisionBehavior::Request);
+BENCHMARK_TEMPLATE(BM_DecodeLoadUnaligned, robot::SetCollisionBehavior::Request);
+BENCHMARK_TEMPLATE(BM_DecodeReinterpretCast, robot::GetCartesianLimit::Response);
+BENCHMARK_TEMPLATE(BM_DecodeBitCast, robot::GetCartesianLimit::Response);
+BENCHMARK_TEMPLATE(BM_DecodeReinterpretCast, robot::Connect::Request);
+BENCHMARK_TEMPLATE(BM_DecodeBitCast, robot::Connect::Request);
+BENCHMARK_TEMPLATE(BM_DecodeReinterpretCast, robot::RobotState);
+BENCHMARK_TEMPLATE(BM_DecodeBitCast, robot::RobotState);
+BENCHMARK_TEMPLATE(BM_DecodeLoadUnaligned, robot::RobotState);
+BENCHMARK(BM_ReadFieldReinterpretCast);
+BENCHMARK(BM_ReadFieldBitCast);
+BENCHMARK(BM_ReadFieldLoadField);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
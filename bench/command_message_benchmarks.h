@@ -0,0 +1,208 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <research_interface/message_encoding.h>
+
+namespace research_interface {
+namespace bench {
+
+template <typename T, typename P>
+using MessageOf = typename T::template Message<P>;
+
+template <typename T>
+typename T::Request makeDefaultRequest() {
+  return typename T::Request();
+}
+
+template <typename T>
+typename T::Response makeDefaultResponse() {
+  return typename T::Response(T::Status::kSuccess);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/**
+ * Connected pair of local datagram sockets. Benchmarks send each message on one end and receive
+ * it on the other, so that the socket never fills up.
+ */
+class SocketPair {
+ public:
+  SocketPair() noexcept {
+    if (::socketpair(AF_UNIX, SOCK_DGRAM, 0, sockets_) != 0) {
+      sockets_[0] = sockets_[1] = -1;
+    }
+  }
+
+  ~SocketPair() {
+    if (valid()) {
+      ::close(sockets_[0]);
+      ::close(sockets_[1]);
+    }
+  }
+
+  SocketPair(const SocketPair&) = delete;
+  SocketPair& operator=(const SocketPair&) = delete;
+
+  bool valid() const noexcept { return sockets_[0] != -1; }
+  int sender() const noexcept { return sockets_[0]; }
+
+  void drain() noexcept {
+    uint8_t buffer[4096];
+    benchmark::DoNotOptimize(::recv(sockets_[1], buffer, sizeof(buffer), 0));
+  }
+
+ private:
+  int sockets_[2];
+};
+
+#endif
+
+/**
+ * Registers construction, CommandMessage packing, getInstance() decoding, copying into a send
+ * buffer and direct encoding into a send buffer for one request or response type P of command T.
+ * PackCopy builds a CommandMessage and copies it into the send buffer, which is the work Encode
+ * replaces. EncodeSend and Writev send the message over a local socket, once from an encoded
+ * buffer and once as header and payload I/O vectors without encoding.
+ */
+template <typename T, typename P, typename Make>
+void registerPayload(const std::string& name, Make make) {
+  using Message = MessageOf<T, P>;
+
+  benchmark::RegisterBenchmark((name + "/Construct").c_str(), [make](benchmark::State& state) {
+    for (auto _ : state) {
+      const P instance = make();
+      benchmark::DoNotOptimize(instance);
+    }
+  });
+
+  benchmark::RegisterBenchmark((name + "/Pack").c_str(), [make](benchmark::State& state) {
+    const P instance = make();
+    uint32_t command_id = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(instance);
+      const Message message(typename T::Header(T::kCommand, command_id++, sizeof(Message)),
+                            instance);
+      benchmark::DoNotOptimize(message);
+    }
+  });
+
+  benchmark::RegisterBenchmark((name + "/Decode").c_str(), [make](benchmark::State& state) {
+    Message message(typename T::Header(T::kCommand, 0, sizeof(Message)), make());
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(message);
+      const P instance = message.getInstance();
+      benchmark::DoNotOptimize(instance);
+    }
+  });
+
+  benchmark::RegisterBenchmark((name + "/Copy").c_str(), [make](benchmark::State& state) {
+    Message message(typename T::Header(T::kCommand, 0, sizeof(Message)), make());
+    std::array<uint8_t, sizeof(Message)> buffer;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(message);
+      std::memcpy(buffer.data(), &message, sizeof(message));
+      benchmark::DoNotOptimize(buffer);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(Message)));
+  });
+
+  benchmark::RegisterBenchmark((name + "/PackCopy").c_str(), [make](benchmark::State& state) {
+    const P instance = make();
+    std::array<uint8_t, sizeof(Message)> buffer;
+    uint32_t command_id = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(instance);
+      const Message message(typename T::Header(T::kCommand, command_id++, sizeof(Message)),
+                            instance);
+      std::memcpy(buffer.data(), &message, sizeof(message));
+      benchmark::DoNotOptimize(buffer);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(Message)));
+  });
+
+  benchmark::RegisterBenchmark((name + "/Encode").c_str(), [make](benchmark::State& state) {
+    const P instance = make();
+    std::array<uint8_t, sizeof(Message)> buffer;
+    uint32_t command_id = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(instance);
+      encodeMessage<T>(command_id++, instance, buffer.data(), buffer.size());
+      benchmark::DoNotOptimize(buffer);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(Message)));
+  });
+
+#if defined(__unix__) || defined(__APPLE__)
+  benchmark::RegisterBenchmark((name + "/EncodeSend").c_str(), [make](benchmark::State& state) {
+    SocketPair sockets;
+    if (!sockets.valid()) {
+      state.SkipWithError("socketpair failed");
+      return;
+    }
+    const P instance = make();
+    std::array<uint8_t, sizeof(Message)> buffer;
+    uint32_t command_id = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(instance);
+      const size_t size = encodeMessage<T>(command_id++, instance, buffer.data(), buffer.size());
+      benchmark::DoNotOptimize(::send(sockets.sender(), buffer.data(), size, 0));
+      sockets.drain();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(Message)));
+  });
+
+  benchmark::RegisterBenchmark((name + "/Writev").c_str(), [make](benchmark::State& state) {
+    SocketPair sockets;
+    if (!sockets.valid()) {
+      state.SkipWithError("socketpair failed");
+      return;
+    }
+    const P instance = make();
+    uint32_t command_id = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(instance);
+      const typename T::Header header = makeHeader<T, P>(command_id++);
+      iovec vectors[2];
+      const size_t count = makeIoVectors(header, instance, vectors);
+      benchmark::DoNotOptimize(::writev(sockets.sender(), vectors, static_cast<int>(count)));
+      sockets.drain();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(Message)));
+  });
+#endif
+}
+
+template <typename T, typename MakeRequest, typename MakeResponse>
+void registerCommand(const std::string& name,
+                     MakeRequest make_request,
+                     MakeResponse make_response) {
+  registerPayload<T, typename T::Request>(name + "/Request", make_request);
+  registerPayload<T, typename T::Response>(name + "/Response", make_response);
+}
+
+template <typename T, typename MakeRequest>
+void registerCommand(const std::string& name, MakeRequest make_request) {
+  registerCommand<T>(name, make_request, makeDefaultResponse<T>);
+}
+
+template <typename T>
+void registerCommand(const std::string& name) {
+  registerCommand<T>(name, makeDefaultRequest<T>, makeDefaultResponse<T>);
+}
+
+}  // namespace bench
+}  // namespace research_interface
@@ -0,0 +1,26 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <research_interface/gripper/types.h>
+
+#include "command_message_benchmarks.h"
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+using namespace gripper;  // NOLINT(google-build-using-namespace)
+
+const bool kRegistered = [] {
+  registerCommand<Connect>("gripper/Connect", [] { return Connect::Request(1338); });
+  registerCommand<Homing>("gripper/Homing");
+  registerCommand<Grasp>("gripper/Grasp", [] {
+    return Grasp::Request(0.02, Grasp::GraspEpsilon(0.005, 0.005), 0.1, 40.0);
+  });
+  registerCommand<Move>("gripper/Move", [] { return Move::Request(0.08, 0.1); });
+  registerCommand<Stop>("gripper/Stop");
+  return true;
+}();
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
@@ -0,0 +1,48 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <array>
+
+#include <benchmark/benchmark.h>
+
+#include <research_interface/robot/joint_impedance_controller.h>
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+robot::RobotState makeRobotState() {
+  robot::RobotState robot_state{};
+  robot_state.q = {{0.0, -0.785, 0.0, -2.356, 0.0, 1.571, 0.785}};
+  robot_state.q_d = {{0.01, -0.78, 0.0, -2.35, 0.0, 1.57, 0.79}};
+  robot_state.dq = {{0.01, -0.02, 0.0, 0.03, 0.0, -0.01, 0.02}};
+  return robot_state;
+}
+
+void BM_JointImpedance(benchmark::State& state) {
+  const robot::RobotState robot_state = makeRobotState();
+  robot::RobotCommand command{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(robot_state);
+    robot::computeJointImpedanceTorques(robot_state, command);
+    benchmark::DoNotOptimize(command);
+  }
+}
+
+void BM_JointImpedanceFeedforward(benchmark::State& state) {
+  const robot::RobotState robot_state = makeRobotState();
+  const std::array<double, 7> feedforward{{0.1, -0.2, 0.1, 0.3, 0.0, -0.1, 0.05}};
+  robot::RobotCommand command{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(robot_state);
+    robot::computeJointImpedanceTorques(robot_state, feedforward, command);
+    benchmark::DoNotOptimize(command);
+  }
+}
+
+BENCHMARK(BM_JointImpedance);
+BENCHMARK(BM_JointImpedanceFeedforward);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
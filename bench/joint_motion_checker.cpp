@@ -0,0 +1,30 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <benchmark/benchmark.h>
+
+#include <research_interface/robot/joint_motion_checker.h>
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+void BM_CheckJointMotion(benchmark::State& state) {
+  const robot::JointMotionChecker checker;
+  robot::RobotState robot_state{};
+  robot_state.motion_generator_mode = robot::MotionGeneratorMode::kJointPosition;
+  robot_state.q_d = {{0.0, -0.785, 0.0, -2.356, 0.0, 1.571, 0.785}};
+  robot::MotionGeneratorCommand command{};
+  command.q_c = robot_state.q_d;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(command);
+    benchmark::DoNotOptimize(robot_state);
+    benchmark::DoNotOptimize(checker.check(command, robot_state));
+  }
+}
+
+BENCHMARK(BM_CheckJointMotion);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
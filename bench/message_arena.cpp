@@ -0,0 +1,46 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <cstdint>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <research_interface/message_arena.h>
+#include <research_interface/message_encoding.h>
+#include <research_interface/robot/service_traits.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+using robot::SetCollisionBehavior;
+
+const SetCollisionBehavior::Request kRequest({}, {}, {}, {}, {}, {}, {}, {});
+
+void BM_EncodeHeap(benchmark::State& state) {
+  for (auto _ : state) {
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[robot::kMaxMessageSize]);
+    encodeMessage<SetCollisionBehavior>(0, kRequest, buffer.get(), robot::kMaxMessageSize);
+    benchmark::DoNotOptimize(buffer.get());
+    benchmark::ClobberMemory();
+  }
+}
+
+void BM_EncodeArena(benchmark::State& state) {
+  using Arena = CommandArena<robot::Registry, 16>;
+  std::unique_ptr<Arena> arena(new Arena);
+  for (auto _ : state) {
+    uint8_t* slot = arena->acquire();
+    encodeMessage<SetCollisionBehavior>(0, kRequest, slot, Arena::kSlotSize);
+    benchmark::DoNotOptimize(slot);
+    benchmark::ClobberMemory();
+    arena->release(slot);
+  }
+}
+
+BENCHMARK(BM_EncodeHeap);
+BENCHMARK(BM_EncodeArena);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
@@ -0,0 +1,110 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <research_interface/codec.h>
+#include <research_interface/message_encoding.h>
+#include <research_interface/robot/message_parser.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+using robot::Command;
+using robot::CommandHeader;
+
+template <typename C>
+void append(const typename C::Request& request, std::vector<uint8_t>& stream, size_t& size) {
+  size += encodeMessage<C>(static_cast<uint32_t>(size), request, stream.data() + size,
+                           stream.size() - size);
+}
+
+std::vector<uint8_t> makeRequestStream() {
+  std::vector<uint8_t> stream(4096);
+  size_t size = 0;
+  append<robot::Connect>(robot::Connect::Request(1338), stream, size);
+  append<robot::StopMove>(robot::StopMove::Request(), stream, size);
+  append<robot::GetCartesianLimit>(robot::GetCartesianLimit::Request(0), stream, size);
+  append<robot::SetJointImpedance>(robot::SetJointImpedance::Request({}), stream, size);
+  append<robot::SetEEToK>(robot::SetEEToK::Request({}), stream, size);
+  append<robot::AutomaticErrorRecovery>(robot::AutomaticErrorRecovery::Request(), stream, size);
+  stream.resize(size);
+  return stream;
+}
+
+struct Sink {
+  template <typename Payload>
+  void operator()(const CommandHeader& header, const Payload& payload) {
+    benchmark::DoNotOptimize(header);
+    benchmark::DoNotOptimize(payload);
+  }
+};
+
+// One switch case per command, as callers wrote it before MessageParser existed.
+template <typename C>
+size_t decodeSwitchCase(const uint8_t* data, Sink& sink) {
+  using Message = typename C::template Message<typename C::Request>;
+  const Message message = loadUnaligned<Message>(data);
+  sink(message.header, message.getInstance());
+  return message.header.size;
+}
+
+void BM_ParseSwitch(benchmark::State& state) {
+  const std::vector<uint8_t> stream = makeRequestStream();
+  Sink sink;
+  for (auto _ : state) {
+    size_t offset = 0;
+    while (offset < stream.size()) {
+      const uint8_t* data = stream.data() + offset;
+      switch (loadUnaligned<CommandHeader>(data).command) {
+        case Command::kConnect:
+          offset += decodeSwitchCase<robot::Connect>(data, sink);
+          break;
+        case Command::kStopMove:
+          offset += decodeSwitchCase<robot::StopMove>(data, sink);
+          break;
+        case Command::kGetCartesianLimit:
+          offset += decodeSwitchCase<robot::GetCartesianLimit>(data, sink);
+          break;
+        case Command::kSetJointImpedance:
+          offset += decodeSwitchCase<robot::SetJointImpedance>(data, sink);
+          break;
+        case Command::kSetEEToK:
+          offset += decodeSwitchCase<robot::SetEEToK>(data, sink);
+          break;
+        case Command::kAutomaticErrorRecovery:
+          offset += decodeSwitchCase<robot::AutomaticErrorRecovery>(data, sink);
+          break;
+        default:
+          offset = stream.size();
+          break;
+      }
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * stream.size());
+}
+
+void BM_Parse(benchmark::State& state) {
+  const std::vector<uint8_t> stream = makeRequestStream();
+  const size_t chunk_size = static_cast<size_t>(state.range(0));
+  robot::RequestParser parser;
+  Sink sink;
+  for (auto _ : state) {
+    for (size_t offset = 0; offset < stream.size(); offset += chunk_size) {
+      parser.parse(stream.data() + offset, std::min(chunk_size, stream.size() - offset), sink);
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * stream.size());
+}
+
+BENCHMARK(BM_ParseSwitch);
+BENCHMARK(BM_Parse)->Arg(1)->Arg(64)->Arg(1500)->Arg(4096);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
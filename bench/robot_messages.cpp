@@ -0,0 +1,65 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <research_interface/robot/service_types.h>
+
+#include "command_message_benchmarks.h"
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+using namespace robot;  // NOLINT(google-build-using-namespace)
+
+const bool kRegistered = [] {
+  registerCommand<Connect>("robot/Connect", [] { return Connect::Request(1338); });
+  registerCommand<Move>("robot/Move", [] {
+    return Move::Request(Move::ControllerMode::kJointImpedance,
+                         Move::MotionGeneratorMode::kJointPosition,
+                         Move::Deviation(10.0, 3.12, 6.28), Move::Deviation(10.0, 3.12, 6.28));
+  });
+  registerCommand<StopMove>("robot/StopMove");
+  registerCommand<GetCartesianLimit>(
+      "robot/GetCartesianLimit", [] { return GetCartesianLimit::Request(1); },
+      [] {
+        return GetCartesianLimit::Response(GetCartesianLimit::Status::kSuccess, {1.0, 2.0, 3.0},
+                                           {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}, true);
+      });
+  registerCommand<SetCollisionBehavior>("robot/SetCollisionBehavior", [] {
+    return SetCollisionBehavior::Request(
+        {20.0, 20.0, 18.0, 18.0, 16.0, 14.0, 12.0}, {20.0, 20.0, 18.0, 18.0, 16.0, 14.0, 12.0},
+        {20.0, 20.0, 18.0, 18.0, 16.0, 14.0, 12.0}, {20.0, 20.0, 18.0, 18.0, 16.0, 14.0, 12.0},
+        {20.0, 20.0, 20.0, 25.0, 25.0, 25.0}, {20.0, 20.0, 20.0, 25.0, 25.0, 25.0},
+        {20.0, 20.0, 20.0, 25.0, 25.0, 25.0}, {20.0, 20.0, 20.0, 25.0, 25.0, 25.0});
+  });
+  registerCommand<SetJointImpedance>("robot/SetJointImpedance", [] {
+    return SetJointImpedance::Request({3000, 3000, 3000, 2500, 2500, 2000, 2000});
+  });
+  registerCommand<SetCartesianImpedance>("robot/SetCartesianImpedance", [] {
+    return SetCartesianImpedance::Request({3000, 3000, 3000, 300, 300, 300});
+  });
+  registerCommand<SetGuidingMode>("robot/SetGuidingMode", [] {
+    return SetGuidingMode::Request({true, true, true, true, true, true}, false);
+  });
+  registerCommand<SetEEToK>("robot/SetEEToK", [] {
+    return SetEEToK::Request({1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1});
+  });
+  registerCommand<SetNEToEE>("robot/SetNEToEE", [] {
+    return SetNEToEE::Request({1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1});
+  });
+  registerCommand<SetLoad>("robot/SetLoad", [] {
+    return SetLoad::Request(0.5, {0.0, 0.0, 0.1}, {0.01, 0, 0, 0, 0.01, 0, 0, 0, 0.01});
+  });
+  registerCommand<SetFilters>("robot/SetFilters", [] {
+    return SetFilters::Request(100.0, 100.0, 100.0, 100.0, 100.0);
+  });
+  registerCommand<AutomaticErrorRecovery>("robot/AutomaticErrorRecovery");
+  registerCommand<LoadModelLibrary>("robot/LoadModelLibrary", [] {
+    return LoadModelLibrary::Request(LoadModelLibrary::Architecture::kX64,
+                                     LoadModelLibrary::System::kLinux);
+  });
+  return true;
+}();
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
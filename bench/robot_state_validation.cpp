@@ -0,0 +1,77 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <benchmark/benchmark.h>
+
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/robot_state_validation.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+using robot::RobotState;
+
+std::array<uint8_t, sizeof(RobotState) + 1> makeDatagram() {
+  RobotState robot_state{};
+  const std::array<double, 16> transform{{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0.3, 0, 0.5, 1}};
+  robot_state.O_T_EE = transform;
+  robot_state.O_T_EE_d = transform;
+  robot_state.F_T_EE = transform;
+  std::array<uint8_t, sizeof(RobotState) + 1> datagram{};
+  std::memcpy(datagram.data() + 1, &robot_state, sizeof(robot_state));
+  return datagram;
+}
+
+// One std::isfinite() per double, walking kRobotStateFields. validateRobotState() instead checks
+// all doubles of the struct in one vectorized pass.
+uint64_t validateScalar(const uint8_t* data) {
+  uint64_t mask = 0;
+  for (size_t i = 0; i < robot::kRobotStateFields.size(); i++) {
+    const FieldDescriptor& field = robot::kRobotStateFields[i];
+    if (field.type != FieldType::kDouble) {
+      continue;
+    }
+    for (size_t j = 0; j < field.count; j++) {
+      double value;
+      std::memcpy(&value, data + field.offset + j * sizeof(double), sizeof(value));
+      if (!std::isfinite(value)) {
+        mask |= uint64_t{1} << i;
+      }
+    }
+  }
+  for (size_t offset : {offsetof(RobotState, O_T_EE), offsetof(RobotState, O_T_EE_d),
+                        offsetof(RobotState, F_T_EE)}) {
+    if (!robot::detail::isHomogeneousTransform(data + offset, robot::kTransformTolerance)) {
+      mask |= robot::getRobotStateFieldMask(offset);
+    }
+  }
+  return mask;
+}
+
+void BM_ValidateRobotStateScalar(benchmark::State& state) {
+  const std::array<uint8_t, sizeof(RobotState) + 1> datagram = makeDatagram();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(datagram);
+    benchmark::DoNotOptimize(validateScalar(datagram.data() + 1));
+  }
+}
+
+void BM_ValidateRobotState(benchmark::State& state) {
+  const std::array<uint8_t, sizeof(RobotState) + 1> datagram = makeDatagram();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(datagram);
+    benchmark::DoNotOptimize(robot::validateRobotState(datagram.data() + 1));
+  }
+}
+
+BENCHMARK(BM_ValidateRobotStateScalar);
+BENCHMARK(BM_ValidateRobotState);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
@@ -0,0 +1,59 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/seqlock.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+Seqlock<robot::RobotState> latest_state;
+std::atomic<bool> writing{false};
+std::thread writer;
+
+// Publishes a new state every millisecond, like the thread receiving states from the robot.
+void startWriter(const benchmark::State&) {
+  writing.store(true, std::memory_order_relaxed);
+  writer = std::thread([] {
+    robot::RobotState robot_state{};
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+    while (writing.load(std::memory_order_relaxed)) {
+      next += std::chrono::milliseconds(1);
+      std::this_thread::sleep_until(next);
+      robot_state.message_id++;
+      latest_state.store(robot_state);
+    }
+  });
+}
+
+void stopWriter(const benchmark::State&) {
+  writing.store(false, std::memory_order_relaxed);
+  writer.join();
+}
+
+// Every benchmark thread is a reader. retries counts the torn reads per successful load.
+void BM_SeqlockRead(benchmark::State& state) {
+  robot::RobotState robot_state;
+  uint64_t retries = 0;
+  for (auto _ : state) {
+    while (!latest_state.tryLoad(robot_state)) {
+      retries++;
+    }
+    benchmark::DoNotOptimize(robot_state);
+  }
+  state.counters["retries"] =
+      benchmark::Counter(static_cast<double>(retries), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_SeqlockRead)->Setup(startWriter)->Teardown(stopWriter)->ThreadRange(1, 8);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
@@ -0,0 +1,111 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <research_interface/latency_histogram.h>
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/spsc_queue.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+struct TimedCommand {
+  int64_t sent;
+  robot::RobotCommand command;
+};
+
+// Same ring as SpscQueue, but guarded by a mutex instead of acquire/release indices.
+template <typename T, size_t Capacity>
+class MutexQueue {
+ public:
+  bool push(const T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tail_ - head_ == Capacity) {
+      return false;
+    }
+    slots_[tail_++ & (Capacity - 1)] = value;
+    return true;
+  }
+
+  bool pop(T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (head_ == tail_) {
+      return false;
+    }
+    value = slots_[head_++ & (Capacity - 1)];
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  size_t head_ = 0;
+  size_t tail_ = 0;
+  std::array<T, Capacity> slots_;
+};
+
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// A producer thread pushes commands at range(0) Hz while the benchmark thread polls the queue.
+// The reported time is the hand-over latency from push to pop.
+template <typename Queue>
+void BM_HandOver(benchmark::State& state) {
+  const std::chrono::nanoseconds period(std::chrono::seconds(1) / state.range(0));
+  Queue queue;
+  std::atomic<bool> running{true};
+  std::thread producer([&] {
+    TimedCommand element{};
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+    while (running.load(std::memory_order_relaxed)) {
+      next += period;
+      std::this_thread::sleep_until(next);
+      element.command.message_id++;
+      element.sent = now();
+      queue.push(element);
+    }
+  });
+
+  LatencyHistogram histogram;
+  TimedCommand element;
+  for (auto _ : state) {
+    while (!queue.pop(element)) {
+      std::this_thread::yield();
+    }
+    const int64_t latency = now() - element.sent;
+    histogram.record(static_cast<uint64_t>(latency));
+    state.SetIterationTime(static_cast<double>(latency) * 1e-9);
+  }
+  running.store(false, std::memory_order_relaxed);
+  producer.join();
+
+  state.counters["p50_ns"] = static_cast<double>(histogram.getPercentile(50.0));
+  state.counters["p99_ns"] = static_cast<double>(histogram.getPercentile(99.0));
+  state.counters["max_ns"] = static_cast<double>(histogram.max());
+}
+
+BENCHMARK_TEMPLATE(BM_HandOver, SpscQueue<TimedCommand, 64>)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Iterations(2000)
+    ->UseManualTime();
+BENCHMARK_TEMPLATE(BM_HandOver, MutexQueue<TimedCommand, 64>)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Iterations(2000)
+    ->UseManualTime();
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
@@ -0,0 +1,83 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include <benchmark/benchmark.h>
+
+#include <research_interface/gripper/types.h>
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/robot_state_view.h>
+#include <research_interface/vacuum_gripper/types.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+template <typename T>
+void BM_Receive(benchmark::State& state) {
+  std::array<uint8_t, sizeof(T) + 1> datagram{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(datagram);
+    T instance;
+    std::memcpy(&instance, datagram.data() + 1, sizeof(instance));
+    benchmark::DoNotOptimize(instance);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(T)));
+}
+
+template <typename T>
+void BM_Send(benchmark::State& state) {
+  const T instance{};
+  std::array<uint8_t, sizeof(T)> datagram;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(instance);
+    std::memcpy(datagram.data(), &instance, sizeof(instance));
+    benchmark::DoNotOptimize(datagram);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(T)));
+}
+
+BENCHMARK_TEMPLATE(BM_Receive, robot::RobotState);
+BENCHMARK_TEMPLATE(BM_Send, robot::RobotCommand);
+BENCHMARK_TEMPLATE(BM_Receive, robot::RobotCommand);
+BENCHMARK_TEMPLATE(BM_Receive, gripper::GripperState);
+BENCHMARK_TEMPLATE(BM_Receive, vacuum_gripper::VacuumGripperState);
+
+// Reading the fields a joint-space controller needs, after copying the whole state out of the
+// datagram or directly through a RobotStateView.
+void BM_RobotStateCopyThenRead(benchmark::State& state) {
+  std::array<uint8_t, sizeof(robot::RobotState) + 1> datagram{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(datagram);
+    robot::RobotState robot_state;
+    std::memcpy(&robot_state, datagram.data() + 1, sizeof(robot_state));
+    const std::array<double, 7> q = robot_state.q;
+    const std::array<double, 7> dq = robot_state.dq;
+    const std::array<double, 7> tau_J = robot_state.tau_J;
+    benchmark::DoNotOptimize(q);
+    benchmark::DoNotOptimize(dq);
+    benchmark::DoNotOptimize(tau_J);
+  }
+}
+BENCHMARK(BM_RobotStateCopyThenRead);
+
+void BM_RobotStateViewRead(benchmark::State& state) {
+  std::array<uint8_t, sizeof(robot::RobotState) + 1> datagram{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(datagram);
+    const robot::RobotStateView view(datagram.data() + 1);
+    const std::array<double, 7> q = view.q();
+    const std::array<double, 7> dq = view.dq();
+    const std::array<double, 7> tau_J = view.tau_J();
+    benchmark::DoNotOptimize(q);
+    benchmark::DoNotOptimize(dq);
+    benchmark::DoNotOptimize(tau_J);
+  }
+}
+BENCHMARK(BM_RobotStateViewRead);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
@@ -0,0 +1,26 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <benchmark/benchmark.h>
+
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/torque_rate_limiter.h>
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+void BM_LimitTorqueRate(benchmark::State& state) {
+  robot::TorqueRateLimiter<> limiter;
+  robot::ControllerCommand command{};
+  for (auto _ : state) {
+    command.tau_J_d = {{5.0, -5.0, 0.5, -0.5, 20.0, -20.0, 0.0}};
+    benchmark::DoNotOptimize(command);
+    benchmark::DoNotOptimize(limiter.limit(command));
+  }
+}
+
+BENCHMARK(BM_LimitTorqueRate);
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
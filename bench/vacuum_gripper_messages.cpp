@@ -0,0 +1,28 @@
+// Copyright (c) 2019 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#include <chrono>
+
+#include <research_interface/vacuum_gripper/types.h>
+
+#include "command_message_benchmarks.h"
+
+namespace research_interface {
+namespace bench {
+namespace {
+
+using namespace vacuum_gripper;  // NOLINT(google-build-using-namespace)
+
+const bool kRegistered = [] {
+  registerCommand<Connect>("vacuum_gripper/Connect", [] { return Connect::Request(1339); });
+  registerCommand<Vacuum>("vacuum_gripper/Vacuum", [] {
+    return Vacuum::Request(100, Profile::kP0, std::chrono::milliseconds(1000));
+  });
+  registerCommand<DropOff>("vacuum_gripper/DropOff",
+                           [] { return DropOff::Request(std::chrono::milliseconds(1000)); });
+  registerCommand<Stop>("vacuum_gripper/Stop");
+  return true;
+}();
+
+}  // anonymous namespace
+}  // namespace bench
+}  // namespace research_interface
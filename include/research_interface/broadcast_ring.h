@@ -0,0 +1,87 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <research_interface/seqlock.h>
+#include <research_interface/spsc_queue.h>
+
+namespace research_interface {
+
+/**
+ * Single-writer ring buffer that any number of readers can follow independently.
+ *
+ * The writer never blocks and overwrites the oldest element when the ring is full. Every reader
+ * keeps its own read index and detects when it fell behind by more than Capacity elements.
+ * The ring is address-free, so it can also be placed in shared memory.
+ *
+ * @tparam T Trivially copyable element type.
+ * @tparam Capacity Number of slots, must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class BroadcastRing {
+ public:
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two.");
+
+  enum class ReadResult : uint8_t { kSuccess, kEmpty, kOverrun };
+
+  static constexpr size_t kCapacity = Capacity;
+
+  BroadcastRing() = default;
+  BroadcastRing(const BroadcastRing&) = delete;
+  BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+  /**
+   * Appends a value, overwriting the oldest one if the ring is full. Writer only.
+   */
+  void push(const T& value) noexcept {
+    const uint64_t index = end_.load(std::memory_order_relaxed);
+    slots_[index & (Capacity - 1)].store(Entry{index, value});
+    end_.store(index + 1, std::memory_order_release);
+  }
+
+  /**
+   * Index one past the most recently pushed element.
+   */
+  uint64_t end() const noexcept { return end_.load(std::memory_order_acquire); }
+
+  /**
+   * Reads the element with the given index.
+   *
+   * @param[in] index Index of the element, as counted since construction.
+   * @param[out] value Set to the element on success.
+   *
+   * @return kEmpty if the element was not pushed yet, kOverrun if it was already overwritten or
+   * is being overwritten. Never blocks, even if the writer died in the middle of a push().
+   */
+  ReadResult read(uint64_t index, T& value) const noexcept {
+    if (index >= end()) {
+      return ReadResult::kEmpty;
+    }
+    // The element was completely written before end() passed it, so a torn read means that the
+    // writer is already overwriting the slot with a newer element.
+    Entry entry;
+    if (!slots_[index & (Capacity - 1)].tryLoad(entry) || entry.index != index) {
+      return ReadResult::kOverrun;
+    }
+    value = entry.value;
+    return ReadResult::kSuccess;
+  }
+
+ private:
+  struct Entry {
+    uint64_t index;
+    T value;
+  };
+
+  alignas(kCacheLineSize) std::atomic<uint64_t> end_{0};
+  std::array<Seqlock<Entry>, Capacity> slots_;
+};
+
+}  // namespace research_interface
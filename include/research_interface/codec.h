@@ -0,0 +1,172 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define RESEARCH_INTERFACE_HAS_BUILTIN_BIT_CAST 1
+#endif
+#endif
+#ifndef RESEARCH_INTERFACE_HAS_BUILTIN_BIT_CAST
+#define RESEARCH_INTERFACE_HAS_BUILTIN_BIT_CAST 0
+#endif
+
+namespace research_interface {
+
+namespace detail {
+
+template <typename T, typename Source>
+T bitCast(const Source& source, std::true_type /* default-constructible */) noexcept {
+  T result;
+  std::memcpy(&result, &source, sizeof(T));
+  return result;
+}
+
+template <typename T, typename Source>
+T bitCast(const Source& source, std::false_type /* default-constructible */) noexcept {
+#if defined(__cpp_lib_bit_cast)
+  return std::bit_cast<T>(source);
+#elif RESEARCH_INTERFACE_HAS_BUILTIN_BIT_CAST
+  return __builtin_bit_cast(T, source);
+#else
+  // memcpy into suitable storage implicitly creates the T there (P0593, adopted as a defect
+  // report for all language modes).
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  std::memcpy(&storage, &source, sizeof(T));
+  return *reinterpret_cast<const T*>(&storage);
+#endif
+}
+
+// Storage for a T whose lifetime starts when its object representation is copied in (P0593).
+template <typename T>
+union Staging {
+  Staging() noexcept {}
+  T value;
+};
+
+template <typename T>
+T loadUnaligned(const uint8_t* data, std::true_type /* default-constructible */) noexcept {
+  T result;
+  std::memcpy(&result, data, sizeof(T));
+  return result;
+}
+
+#if defined(__GNUC__)
+// GCC and Clang let may_alias types read the object representation of any object.
+template <typename T>
+struct __attribute__((__may_alias__)) MayAlias {
+  T value;
+};
+#endif
+
+template <typename T>
+T loadUnaligned(const uint8_t* data, std::false_type /* default-constructible */) noexcept {
+#if defined(__GNUC__)
+  // GCC does not elide the copy out of Staging. Packed wire types are valid at any address, so
+  // they are read directly instead.
+  if (alignof(T) == 1) {
+    return reinterpret_cast<const MayAlias<T>*>(data)->value;
+  }
+#endif
+  Staging<T> staging;
+  std::memcpy(static_cast<void*>(&staging.value), data, sizeof(T));
+  return staging.value;
+}
+
+template <typename T>
+T loadField(const uint8_t* data, std::false_type /* packed access */) noexcept {
+  return loadUnaligned<T>(data, std::is_default_constructible<T>());
+}
+
+#if defined(__GNUC__)
+// Packing is only honored for POD members; GCC then reads them with unaligned loads.
+template <typename T>
+struct __attribute__((__packed__, __may_alias__)) PackedMayAlias {
+  T value;
+};
+
+template <typename T>
+T loadField(const uint8_t* data, std::true_type /* packed access */) noexcept {
+  return reinterpret_cast<const PackedMayAlias<T>*>(data)->value;
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * Reinterprets the object representation of source as a T, like C++20 std::bit_cast.
+ *
+ * Unlike dereferencing a reinterpret_cast pointer to the source bytes, this does not violate
+ * strict aliasing. Default-constructible types are copied into a T. The request and response
+ * structs have const members and are not default-constructible; they go through std::bit_cast or
+ * __builtin_bit_cast where available.
+ *
+ * GCC stages the result of __builtin_bit_cast on the stack, so a single field read from a decoded
+ * struct, e.g. `getInstance().object_frame[13]`, copies the whole struct first. Code that only
+ * needs single fields reads them with loadField() instead.
+ */
+template <typename T, typename Source>
+T bitCast(const Source& source) noexcept {
+  static_assert(sizeof(T) == sizeof(Source), "T and Source must have the same size.");
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  static_assert(std::is_trivially_copyable<Source>::value, "Source must be trivially copyable.");
+  return detail::bitCast<T>(source, std::is_default_constructible<T>());
+}
+
+/**
+ * Reads a T from data, which may have any alignment.
+ */
+template <typename T>
+T loadUnaligned(const uint8_t* data) noexcept {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  return detail::loadUnaligned<T>(data, std::is_default_constructible<T>());
+}
+
+/**
+ * Reads one member of a T from the object representation of a T at data, which may have any
+ * alignment, e.g. `loadField<Response>(message.payload.data(), &Response::object_frame)`.
+ *
+ * Unlike `bitCast<T>(...).*member`, this compiles to a direct load of the member, like the
+ * reinterpret_cast it replaces. Works for types that are not standard layout, where offsetof is
+ * not supported.
+ */
+template <typename T, typename Field, typename Class>
+typename std::remove_cv<Field>::type loadField(const uint8_t* data,
+                                               Field Class::*member) noexcept {
+  static_assert(std::is_base_of<Class, T>::value, "member must be a member of T.");
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  // Only used to find the offset of the member, which offsetof does not support for all T.
+  const detail::Staging<T> staging;
+  const size_t offset = static_cast<size_t>(
+      reinterpret_cast<const uint8_t*>(&(staging.value.*member)) -
+      reinterpret_cast<const uint8_t*>(&staging.value));
+  using Value = typename std::remove_cv<Field>::type;
+#if defined(__GNUC__)
+  using PackedAccess = std::integral_constant<bool, std::is_pod<Value>::value>;
+#else
+  using PackedAccess = std::false_type;
+#endif
+  return detail::loadField<Value>(data + offset, PackedAccess());
+}
+
+/**
+ * Writes value to data, which may have any alignment.
+ */
+template <typename T>
+void storeUnaligned(uint8_t* data, const T& value) noexcept {
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  std::memcpy(data, &value, sizeof(T));
+}
+
+}  // namespace research_interface
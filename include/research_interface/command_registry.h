@@ -0,0 +1,138 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+#include <research_interface/message_encoding.h>
+#include <research_interface/type_list.h>
+
+namespace research_interface {
+
+namespace detail {
+
+constexpr bool isSequence(std::initializer_list<size_t> values) noexcept {
+  size_t expected = 0;
+  for (size_t value : values) {
+    if (value != expected++) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace detail
+
+template <typename Commands, template <typename> class Traits>
+struct CommandRegistry;
+
+/**
+ * Compile-time registry of the commands of one namespace.
+ *
+ * Maps command values to command types and back, and provides the request and response message
+ * sizes (including the header) and names of all commands. Everything except visit() is
+ * constexpr, so lookup tables, receive buffers and dispatch tables can be generated from it.
+ *
+ * @tparam Commands TypeList of all command types, in command order.
+ * @tparam Traits Command traits of the namespace, providing kName.
+ */
+template <typename... Cs, template <typename> class Traits>
+struct CommandRegistry<TypeList<Cs...>, Traits> {
+  using Commands = TypeList<Cs...>;
+  using Header = typename TypeAt<0, Commands>::type::Header;
+  using Command = typename std::remove_const<decltype(TypeAt<0, Commands>::type::kCommand)>::type;
+
+  static constexpr size_t kCount = sizeof...(Cs);
+
+  static_assert(detail::isSequence({static_cast<size_t>(Cs::kCommand)...}),
+                "Commands must be ordered by their command value.");
+
+  /// Command type for the command value C.
+  template <Command C>
+  using Type = typename TypeAt<static_cast<size_t>(C), Commands>::type;
+
+  /// Command value of the command type C.
+  template <typename C>
+  static constexpr Command getCommand() noexcept {
+    static_assert(IndexOf<C, Commands>::value < kCount, "C is not a registered command.");
+    return C::kCommand;
+  }
+
+  static constexpr bool contains(Command command) noexcept {
+    return static_cast<size_t>(command) < kCount;
+  }
+
+  static constexpr const char* getName(Command command) noexcept {
+    const char* const kNames[] = {Traits<Cs>::kName...};
+    return contains(command) ? kNames[static_cast<size_t>(command)] : "Unknown";
+  }
+
+  /// Size of the request message, or 0 for unknown commands.
+  static constexpr size_t getRequestSize(Command command) noexcept {
+    return contains(command) ? kRequestSizes[static_cast<size_t>(command)] : 0;
+  }
+
+  /// Size of the response message, or 0 for unknown commands.
+  static constexpr size_t getResponseSize(Command command) noexcept {
+    return contains(command) ? kResponseSizes[static_cast<size_t>(command)] : 0;
+  }
+
+  static constexpr size_t kMaxRequestSize =
+      std::max({getMessageSize<Cs, typename Cs::Request>()...});
+  static constexpr size_t kMaxResponseSize =
+      std::max({getMessageSize<Cs, typename Cs::Response>()...});
+  static constexpr size_t kMaxMessageSize = std::max(kMaxRequestSize, kMaxResponseSize);
+
+  /**
+   * Calls visitor with a TypeTag of the command type for the given command value.
+   *
+   * @return False if the command is unknown and visitor was not called.
+   */
+  template <typename Visitor>
+  static bool visit(Command command, Visitor&& visitor) {
+    if (!contains(command)) {
+      return false;
+    }
+    using Handler = void (*)(Visitor&);
+    static constexpr Handler kHandlers[] = {&call<Cs, Visitor>...};
+    kHandlers[static_cast<size_t>(command)](visitor);
+    return true;
+  }
+
+ private:
+  // Static tables rather than local arrays, so that runtime lookups do not rebuild them.
+  static constexpr std::array<size_t, sizeof...(Cs)> kRequestSizes{
+      {getMessageSize<Cs, typename Cs::Request>()...}};
+  static constexpr std::array<size_t, sizeof...(Cs)> kResponseSizes{
+      {getMessageSize<Cs, typename Cs::Response>()...}};
+
+  template <typename C, typename Visitor>
+  static void call(Visitor& visitor) {
+    visitor(TypeTag<C>());
+  }
+};
+
+template <typename... Cs, template <typename> class Traits>
+constexpr size_t CommandRegistry<TypeList<Cs...>, Traits>::kCount;
+
+template <typename... Cs, template <typename> class Traits>
+constexpr size_t CommandRegistry<TypeList<Cs...>, Traits>::kMaxRequestSize;
+
+template <typename... Cs, template <typename> class Traits>
+constexpr size_t CommandRegistry<TypeList<Cs...>, Traits>::kMaxResponseSize;
+
+template <typename... Cs, template <typename> class Traits>
+constexpr size_t CommandRegistry<TypeList<Cs...>, Traits>::kMaxMessageSize;
+
+template <typename... Cs, template <typename> class Traits>
+constexpr std::array<size_t, sizeof...(Cs)> CommandRegistry<TypeList<Cs...>, Traits>::kRequestSizes;
+
+template <typename... Cs, template <typename> class Traits>
+constexpr std::array<size_t, sizeof...(Cs)>
+    CommandRegistry<TypeList<Cs...>, Traits>::kResponseSizes;
+
+}  // namespace research_interface
@@ -0,0 +1,126 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace research_interface {
+
+/**
+ * Element type of a wire struct field. Enums are described by their underlying type.
+ */
+enum class FieldType : uint8_t {
+  kBool,
+  kUint8,
+  kUint16,
+  kUint32,
+  kUint64,
+  kInt32,
+  kInt64,
+  kDouble
+};
+
+/**
+ * Describes one field of a packed wire struct.
+ */
+struct FieldDescriptor {
+  const char* name;
+  size_t offset;
+  FieldType type;
+  size_t count;
+};
+
+template <typename T, typename Enable = void>
+struct FieldTypeOf;
+
+template <>
+struct FieldTypeOf<bool> : std::integral_constant<FieldType, FieldType::kBool> {};
+
+template <>
+struct FieldTypeOf<uint8_t> : std::integral_constant<FieldType, FieldType::kUint8> {};
+
+template <>
+struct FieldTypeOf<uint16_t> : std::integral_constant<FieldType, FieldType::kUint16> {};
+
+template <>
+struct FieldTypeOf<uint32_t> : std::integral_constant<FieldType, FieldType::kUint32> {};
+
+template <>
+struct FieldTypeOf<uint64_t> : std::integral_constant<FieldType, FieldType::kUint64> {};
+
+template <>
+struct FieldTypeOf<int32_t> : std::integral_constant<FieldType, FieldType::kInt32> {};
+
+template <>
+struct FieldTypeOf<int64_t> : std::integral_constant<FieldType, FieldType::kInt64> {};
+
+template <>
+struct FieldTypeOf<double> : std::integral_constant<FieldType, FieldType::kDouble> {};
+
+template <typename T>
+struct FieldTypeOf<T, typename std::enable_if<std::is_enum<T>::value>::type>
+    : FieldTypeOf<typename std::underlying_type<T>::type> {};
+
+template <typename T>
+struct FieldCountOf : std::integral_constant<size_t, 1> {};
+
+template <typename T, size_t N>
+struct FieldCountOf<std::array<T, N>> : std::integral_constant<size_t, N> {};
+
+template <typename T>
+struct FieldElementOf {
+  using type = T;
+};
+
+template <typename T, size_t N>
+struct FieldElementOf<std::array<T, N>> {
+  using type = T;
+};
+
+/**
+ * Creates a FieldDescriptor for a member of type T, deriving element type and count from T.
+ */
+template <typename T>
+constexpr FieldDescriptor makeField(const char* name, size_t offset) noexcept {
+  return FieldDescriptor{name, offset, FieldTypeOf<typename FieldElementOf<T>::type>::value,
+                         FieldCountOf<T>::value};
+}
+
+/**
+ * Creates the FieldDescriptor of Struct::member, named like the member. Nested members can be
+ * given as a path, e.g. motion.q_c.
+ */
+#define RESEARCH_INTERFACE_FIELD(Struct, member) \
+  ::research_interface::makeField<decltype(Struct::member)>(#member, offsetof(Struct, member))
+
+constexpr size_t getFieldTypeSize(FieldType type) noexcept {
+  return type == FieldType::kBool || type == FieldType::kUint8
+             ? 1
+             : type == FieldType::kUint16
+                   ? 2
+                   : type == FieldType::kUint32 || type == FieldType::kInt32 ? 4 : 8;
+}
+
+constexpr size_t getFieldSize(const FieldDescriptor& field) noexcept {
+  return getFieldTypeSize(field.type) * field.count;
+}
+
+/**
+ * Checks that the given fields are ordered, contiguous and cover exactly `size` bytes.
+ */
+template <size_t N>
+constexpr bool coversExactly(const std::array<FieldDescriptor, N>& fields, size_t size) noexcept {
+  size_t expected_offset = 0;
+  for (size_t i = 0; i < N; i++) {
+    if (fields[i].offset != expected_offset) {
+      return false;
+    }
+    expected_offset += getFieldSize(fields[i]);
+  }
+  return expected_offset == size;
+}
+
+}  // namespace research_interface
@@ -0,0 +1,26 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <research_interface/field_descriptor.h>
+#include <research_interface/gripper/types.h>
+
+namespace research_interface {
+namespace gripper {
+
+constexpr std::array<FieldDescriptor, 5> kGripperStateFields{{
+    RESEARCH_INTERFACE_FIELD(GripperState, message_id),
+    RESEARCH_INTERFACE_FIELD(GripperState, width),
+    RESEARCH_INTERFACE_FIELD(GripperState, max_width),
+    RESEARCH_INTERFACE_FIELD(GripperState, is_grasped),
+    RESEARCH_INTERFACE_FIELD(GripperState, temperature)
+}};
+
+static_assert(coversExactly(kGripperStateFields, sizeof(GripperState)),
+              "kGripperStateFields must cover GripperState exactly.");
+
+}  // namespace gripper
+}  // namespace research_interface
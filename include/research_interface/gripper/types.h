@@ -7,6 +7,8 @@
 #include <cstring>
 #include <type_traits>
 
+#include <research_interface/codec.h>
+
 namespace research_interface {
 namespace gripper {
 
@@ -53,7 +55,7 @@ struct CommandMessage {
     std::memcpy(payload.data(), &instance, payload.size());
   }
 
-  T getInstance() const noexcept { return *reinterpret_cast<const T*>(payload.data()); }
+  T getInstance() const noexcept { return bitCast<T>(payload); }
 
   CommandHeader header;
   std::array<uint8_t, sizeof(T)> payload;
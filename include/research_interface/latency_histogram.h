@@ -0,0 +1,101 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace research_interface {
+
+/**
+ * Fixed-size log-linear histogram in the style of HdrHistogram.
+ *
+ * Values are grouped into 16 sub-buckets per power of two, so every recorded value is known to
+ * within 1/16 (6.25%) across the whole uint64_t range. Recording is O(1) and never allocates.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr size_t kSubBucketBits = 4;
+  static constexpr size_t kSubBucketCount = size_t{1} << kSubBucketBits;
+  static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBucketCount;
+
+  void record(uint64_t value) noexcept {
+    buckets_[getBucketIndex(value)]++;
+    count_++;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  void reset() noexcept {
+    buckets_.fill(0);
+    count_ = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+  }
+
+  uint64_t count() const noexcept { return count_; }
+  uint64_t min() const noexcept { return count_ > 0 ? min_ : 0; }
+  uint64_t max() const noexcept { return max_; }
+
+  /**
+   * Returns an upper bound of the given percentile of all recorded values.
+   *
+   * @param[in] percentile Percentile in [0, 100].
+   */
+  uint64_t getPercentile(double percentile) const noexcept {
+    if (count_ == 0) {
+      return 0;
+    }
+    const double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    const uint64_t rank =
+        std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100.0 * count_ + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; i++) {
+      seen += buckets_[i];
+      if (seen >= rank) {
+        return std::min(getBucketUpperBound(i), max_);
+      }
+    }
+    return max_;
+  }
+
+  static size_t getBucketIndex(uint64_t value) noexcept {
+    if (value < kSubBucketCount) {
+      return static_cast<size_t>(value);
+    }
+    const size_t shift = getMostSignificantBit(value) - kSubBucketBits;
+    return shift * kSubBucketCount + static_cast<size_t>(value >> shift);
+  }
+
+  static uint64_t getBucketUpperBound(size_t index) noexcept {
+    if (index < kSubBucketCount) {
+      return index;
+    }
+    const size_t shift = index / kSubBucketCount;
+    const uint64_t mantissa = index % kSubBucketCount + kSubBucketCount;
+    return ((mantissa + 1) << (shift - 1)) - 1;
+  }
+
+ private:
+  static size_t getMostSignificantBit(uint64_t value) noexcept {
+#if defined(__GNUC__)
+    return static_cast<size_t>(63 - __builtin_clzll(value));
+#else
+    size_t bit = 0;
+    while (value >>= 1) {
+      bit++;
+    }
+    return bit;
+#endif
+  }
+
+  std::array<uint64_t, kBucketCount> buckets_{};
+  uint64_t count_ = 0;
+  uint64_t min_ = std::numeric_limits<uint64_t>::max();
+  uint64_t max_ = 0;
+};
+
+}  // namespace research_interface
@@ -0,0 +1,91 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace research_interface {
+
+/**
+ * Fixed pool of equally sized message buffers.
+ *
+ * All storage is part of the object, so after construction acquire() and release() never
+ * allocate. Both are O(1): free slots are kept on a stack of indices. Not thread-safe; use one
+ * arena per thread, or hand slots to another thread through an SpscQueue.
+ *
+ * @tparam MessageSize Minimum size of a slot in bytes.
+ * @tparam SlotCount Number of slots.
+ */
+template <size_t MessageSize, size_t SlotCount>
+class MessageArena {
+ public:
+  static_assert(MessageSize > 0, "MessageSize must not be zero.");
+  static_assert(SlotCount > 0 && SlotCount <= std::numeric_limits<uint32_t>::max(),
+                "SlotCount out of range.");
+
+  /// Size of a slot, rounded up so that every slot is suitably aligned for any type.
+  static constexpr size_t kSlotSize =
+      (MessageSize + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+      alignof(std::max_align_t);
+  static constexpr size_t kSlotCount = SlotCount;
+
+  MessageArena() noexcept {
+    for (size_t i = 0; i < SlotCount; i++) {
+      free_[i] = static_cast<uint32_t>(SlotCount - 1 - i);
+    }
+  }
+
+  MessageArena(const MessageArena&) = delete;
+  MessageArena& operator=(const MessageArena&) = delete;
+
+  /**
+   * Takes a slot of kSlotSize bytes from the pool.
+   *
+   * @return The slot, or nullptr if all slots are in use.
+   */
+  uint8_t* acquire() noexcept {
+    if (free_count_ == 0) {
+      return nullptr;
+    }
+    return slots_[free_[--free_count_]].data;
+  }
+
+  /**
+   * Returns a slot to the pool.
+   *
+   * @param[in] slot Slot returned by acquire() of this arena that was not released yet.
+   */
+  void release(uint8_t* slot) noexcept {
+    free_[free_count_++] = static_cast<uint32_t>(reinterpret_cast<Slot*>(slot) - slots_.data());
+  }
+
+  bool owns(const uint8_t* slot) const noexcept {
+    const uint8_t* begin = slots_.front().data;
+    const uint8_t* end = begin + sizeof(slots_);
+    return slot >= begin && slot < end && (slot - begin) % sizeof(Slot) == 0;
+  }
+
+  /// Number of slots that can currently be acquired.
+  size_t available() const noexcept { return free_count_; }
+
+ private:
+  struct alignas(std::max_align_t) Slot {
+    uint8_t data[kSlotSize];
+  };
+  static_assert(sizeof(Slot) == kSlotSize, "Slots must not be padded.");
+
+  std::array<Slot, SlotCount> slots_;
+  std::array<uint32_t, SlotCount> free_;
+  size_t free_count_ = SlotCount;
+};
+
+/**
+ * MessageArena whose slots fit every request and response of a CommandRegistry.
+ */
+template <typename Registry, size_t SlotCount>
+using CommandArena = MessageArena<Registry::kMaxMessageSize, SlotCount>;
+
+}  // namespace research_interface
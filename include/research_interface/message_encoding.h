@@ -0,0 +1,110 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#endif
+
+namespace research_interface {
+
+/**
+ * Number of payload bytes a request or response P occupies on the wire. Requests without data
+ * members are sent as a bare header.
+ */
+template <typename P>
+constexpr size_t getPayloadSize() noexcept {
+  return std::is_empty<P>::value ? 0 : sizeof(P);
+}
+
+/**
+ * Number of bytes of a message carrying P for command C, including the header.
+ *
+ * Works for the commands of the robot, gripper and vacuum_gripper namespaces.
+ */
+template <typename C, typename P>
+constexpr size_t getMessageSize() noexcept {
+  static_assert(sizeof(typename C::Header) + getPayloadSize<P>() ==
+                    sizeof(typename C::template Message<P>),
+                "Encoded size must match CommandMessage.");
+  return sizeof(typename C::Header) + getPayloadSize<P>();
+}
+
+/**
+ * Creates the header of a message carrying P for command C.
+ */
+template <typename C, typename P>
+typename C::Header makeHeader(uint32_t command_id) noexcept {
+  return typename C::Header(C::kCommand, command_id, getMessageSize<C, P>());
+}
+
+namespace detail {
+
+/**
+ * Encodes a message for command C from the object representation of a P at payload.
+ */
+template <typename C, typename P>
+size_t encodeMessage(uint32_t command_id,
+                     const void* payload,
+                     uint8_t* buffer,
+                     size_t buffer_size) noexcept {
+  constexpr size_t kSize = getMessageSize<C, P>();
+  if (buffer_size < kSize) {
+    return 0;
+  }
+  const typename C::Header header = makeHeader<C, P>(command_id);
+  std::memcpy(buffer, &header, sizeof(header));
+  std::memcpy(buffer + sizeof(header), payload, getPayloadSize<P>());
+  return kSize;
+}
+
+}  // namespace detail
+
+/**
+ * Encodes a message carrying payload for command C directly into buffer, without building a
+ * CommandMessage first. The result is byte-identical to a CommandMessage.
+ *
+ * @param[in] command_id Command ID of the header.
+ * @param[in] payload Request or response to encode.
+ * @param[out] buffer Destination, may have any alignment.
+ * @param[in] buffer_size Size of buffer.
+ *
+ * @return Number of bytes written, or 0 if buffer is too small.
+ */
+template <typename C, typename P>
+size_t encodeMessage(uint32_t command_id,
+                     const P& payload,
+                     uint8_t* buffer,
+                     size_t buffer_size) noexcept {
+  return detail::encodeMessage<C, P>(command_id, &payload, buffer, buffer_size);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/**
+ * Describes a message as header and payload I/O vectors for a single writev() or sendmsg() call,
+ * without copying either of them. Both header and payload have to outlive the call.
+ *
+ * @param[in] header Header, e.g. created with makeHeader().
+ * @param[in] payload Request or response.
+ * @param[out] vectors I/O vectors to fill.
+ *
+ * @return Number of vectors used, 1 for payloads without data members and 2 otherwise.
+ */
+template <typename Header, typename P>
+size_t makeIoVectors(const Header& header, const P& payload, iovec (&vectors)[2]) noexcept {
+  vectors[0].iov_base = const_cast<Header*>(&header);
+  vectors[0].iov_len = sizeof(header);
+  vectors[1].iov_base = const_cast<P*>(&payload);
+  vectors[1].iov_len = getPayloadSize<P>();
+  return getPayloadSize<P>() == 0 ? 1 : 2;
+}
+
+#endif
+
+}  // namespace research_interface
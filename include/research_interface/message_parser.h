@@ -0,0 +1,166 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <research_interface/codec.h>
+#include <research_interface/command_registry.h>
+#include <research_interface/type_list.h>
+
+namespace research_interface {
+
+enum class MessageKind : uint8_t { kRequest, kResponse };
+
+template <typename C, MessageKind K>
+struct PayloadOf {
+  using type = typename C::Request;
+};
+
+template <typename C>
+struct PayloadOf<C, MessageKind::kResponse> {
+  using type = typename C::Response;
+};
+
+enum class ParserStatus : uint8_t { kOk, kUnknownCommand, kInvalidSize };
+
+template <typename Registry, MessageKind K>
+class MessageParser;
+
+/**
+ * Incremental, allocation-free parser for a stream of command messages.
+ *
+ * Bytes can be fed in chunks of any size. Every complete message is decoded and passed to a
+ * visitor as `visitor(header, payload)`, where payload is the Request or Response (depending on
+ * K) of the command. Dispatch is a single indexed call through a table generated from the
+ * registry. Messages that arrive in one piece are decoded straight from the input; only messages
+ * split across chunks are buffered.
+ *
+ * @tparam Registry CommandRegistry of the namespace.
+ * @tparam K Whether to parse requests or responses.
+ */
+template <typename... Commands, template <typename> class Traits, MessageKind K>
+class MessageParser<CommandRegistry<TypeList<Commands...>, Traits>, K> {
+ public:
+  using Registry = CommandRegistry<TypeList<Commands...>, Traits>;
+  using Header = typename Registry::Header;
+
+  static constexpr size_t kMaxMessageSize =
+      K == MessageKind::kRequest ? Registry::kMaxRequestSize : Registry::kMaxResponseSize;
+
+  /**
+   * Parses the given bytes.
+   *
+   * @param[in] data Next chunk of the stream.
+   * @param[in] size Size of data.
+   * @param[in] visitor Called with header and payload of every complete message.
+   *
+   * @return kOk, or the error that put the parser into a failed state. A failed parser ignores
+   * further input until reset() is called.
+   */
+  template <typename Visitor>
+  ParserStatus parse(const uint8_t* data, size_t size, Visitor&& visitor) {
+    while (status_ == ParserStatus::kOk && size > 0) {
+      if (buffered_ == 0 && size >= sizeof(Header)) {
+        // Fast path: decode complete messages directly from the input.
+        const Header header = loadUnaligned<Header>(data);
+        if (!validate(header)) {
+          break;
+        }
+        if (size >= header.size) {
+          dispatch(header, data, visitor);
+          data += header.size;
+          size -= header.size;
+          continue;
+        }
+      }
+
+      const size_t needed = buffered_ < sizeof(Header)
+                                ? sizeof(Header) - buffered_
+                                : loadUnaligned<Header>(buffer_.data()).size - buffered_;
+      const size_t count = std::min(needed, size);
+      std::memcpy(buffer_.data() + buffered_, data, count);
+      buffered_ += count;
+      data += count;
+      size -= count;
+
+      if (buffered_ < sizeof(Header)) {
+        break;
+      }
+      const Header header = loadUnaligned<Header>(buffer_.data());
+      if (buffered_ == sizeof(Header) && !validate(header)) {
+        break;
+      }
+      if (buffered_ == header.size) {
+        dispatch(header, buffer_.data(), visitor);
+        buffered_ = 0;
+      }
+    }
+    return status_;
+  }
+
+  /**
+   * Discards buffered bytes and clears a failed state.
+   */
+  void reset() noexcept {
+    buffered_ = 0;
+    status_ = ParserStatus::kOk;
+  }
+
+  ParserStatus status() const noexcept { return status_; }
+
+  /// Number of bytes of an incomplete message held back for the next parse() call.
+  size_t buffered() const noexcept { return buffered_; }
+
+ private:
+  bool validate(const Header& header) noexcept {
+    if (!Registry::contains(header.command)) {
+      status_ = ParserStatus::kUnknownCommand;
+      return false;
+    }
+    const size_t expected_size = K == MessageKind::kRequest
+                                     ? Registry::getRequestSize(header.command)
+                                     : Registry::getResponseSize(header.command);
+    if (header.size != expected_size) {
+      status_ = ParserStatus::kInvalidSize;
+      return false;
+    }
+    return true;
+  }
+
+  template <typename Payload>
+  static typename std::enable_if<std::is_empty<Payload>::value, Payload>::type decodePayload(
+      const uint8_t*) noexcept {
+    return Payload();
+  }
+
+  template <typename Payload>
+  static typename std::enable_if<!std::is_empty<Payload>::value, Payload>::type decodePayload(
+      const uint8_t* payload) noexcept {
+    return loadUnaligned<Payload>(payload);
+  }
+
+  template <typename C, typename Visitor>
+  static void decode(const Header& header, const uint8_t* message, Visitor& visitor) {
+    using Payload = typename PayloadOf<C, K>::type;
+    visitor(header, decodePayload<Payload>(message + sizeof(Header)));
+  }
+
+  template <typename Visitor>
+  static void dispatch(const Header& header, const uint8_t* message, Visitor& visitor) {
+    using Handler = void (*)(const Header&, const uint8_t*, Visitor&);
+    static constexpr Handler kHandlers[] = {&decode<Commands, Visitor>...};
+    kHandlers[static_cast<size_t>(header.command)](header, message, visitor);
+  }
+
+  std::array<uint8_t, kMaxMessageSize> buffer_;
+  size_t buffered_ = 0;
+  ParserStatus status_ = ParserStatus::kOk;
+};
+
+}  // namespace research_interface
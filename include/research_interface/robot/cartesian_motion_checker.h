@@ -0,0 +1,265 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <research_interface/robot/error.h>
+#include <research_interface/robot/error_set.h>
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/robot_state_validation.h>
+
+namespace research_interface {
+namespace robot {
+
+/**
+ * Limits a Cartesian motion generator has to respect. Translational and rotational limits apply
+ * to the norms of the respective parts of the twist and its derivatives.
+ */
+struct CartesianMotionLimits {
+  double translational_velocity;
+  double rotational_velocity;
+  double elbow_velocity;
+  double translational_acceleration;
+  double rotational_acceleration;
+  double elbow_acceleration;
+  double translational_jerk;
+  double rotational_jerk;
+  double elbow_jerk;
+  double elbow_min;
+  double elbow_max;
+};
+
+/// Limits from the Panda datasheet; the elbow is bounded by the limits of joint 3.
+constexpr CartesianMotionLimits kDefaultCartesianMotionLimits{
+    1.7, 2.5, 2.175, 13.0, 25.0, 10.0, 6500.0, 12500.0, 5000.0, -2.8973, 2.8973};
+
+namespace detail {
+
+enum RateViolation : uint32_t {
+  kVelocityViolation = 1,
+  kAccelerationViolation = 2,
+  kJerkViolation = 4
+};
+
+/**
+ * Checks the first N components of a velocity against norm limits, with acceleration and jerk as
+ * backward differences from the previous velocity and acceleration.
+ *
+ * @return Mask of RateViolation values. NaNs are reported as violations.
+ */
+template <size_t N>
+inline uint32_t checkRates(const double* velocity,
+                           const double* previous_velocity,
+                           const double* previous_acceleration,
+                           double rate,
+                           double velocity_limit,
+                           double acceleration_limit,
+                           double jerk_limit) noexcept {
+  double velocity_norm = 0.0;
+  double acceleration_norm = 0.0;
+  double jerk_norm = 0.0;
+  for (size_t i = 0; i < N; i++) {
+    const double acceleration = (velocity[i] - previous_velocity[i]) * rate;
+    const double jerk = (acceleration - previous_acceleration[i]) * rate;
+    velocity_norm += velocity[i] * velocity[i];
+    acceleration_norm += acceleration * acceleration;
+    jerk_norm += jerk * jerk;
+  }
+  uint32_t violations = 0;
+  if (!(velocity_norm <= velocity_limit * velocity_limit)) {
+    violations |= kVelocityViolation;
+  }
+  if (!(acceleration_norm <= acceleration_limit * acceleration_limit)) {
+    violations |= kAccelerationViolation;
+  }
+  if (!(jerk_norm <= jerk_limit * jerk_limit)) {
+    violations |= kJerkViolation;
+  }
+  return violations;
+}
+
+/**
+ * Twist that moves the column-major pose `from` to `to` within one period, given its inverse
+ * `rate`. The rotational part is the logarithm of to * from^T.
+ */
+inline std::array<double, 6> getPoseDifference(const std::array<double, 16>& from,
+                                               const std::array<double, 16>& to,
+                                               double rate) noexcept {
+  // R = to * from^T = cos * I + sin * [n]x + (1 - cos) * n * n^T for the axis n.
+  auto element = [&](size_t row, size_t column) {
+    return to[row] * from[column] + to[4 + row] * from[4 + column] + to[8 + row] * from[8 + column];
+  };
+  const double trace = element(0, 0) + element(1, 1) + element(2, 2);
+  const std::array<double, 3> axis{{0.5 * (element(2, 1) - element(1, 2)),
+                                    0.5 * (element(0, 2) - element(2, 0)),
+                                    0.5 * (element(1, 0) - element(0, 1))}};
+  const double sine = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+  const double cosine = 0.5 * (trace - 1.0);
+  const double angle = std::atan2(sine, cosine);
+  std::array<double, 3> rotation;
+  if (cosine >= 0.0) {
+    const double scale = sine > 1e-12 ? angle / sine : 1.0;
+    rotation = {{axis[0] * scale, axis[1] * scale, axis[2] * scale}};
+  } else {
+    // Towards 180 degrees the skew-symmetric part vanishes, so the axis is taken from the
+    // symmetric part instead, starting with its largest component. Only its sign comes from the
+    // skew-symmetric part.
+    size_t largest = 0;
+    for (size_t i = 1; i < 3; i++) {
+      if (element(i, i) > element(largest, largest)) {
+        largest = i;
+      }
+    }
+    std::array<double, 3> direction;
+    direction[largest] = std::sqrt((element(largest, largest) - cosine) / (1.0 - cosine));
+    for (size_t i = 0; i < 3; i++) {
+      if (i != largest) {
+        direction[i] = 0.5 * (element(i, largest) + element(largest, i)) /
+                       ((1.0 - cosine) * direction[largest]);
+      }
+    }
+    const double dot = direction[0] * axis[0] + direction[1] * axis[1] + direction[2] * axis[2];
+    const double scale = dot < 0.0 ? -angle : angle;
+    rotation = {{direction[0] * scale, direction[1] * scale, direction[2] * scale}};
+  }
+  return {{(to[12] - from[12]) * rate, (to[13] - from[13]) * rate, (to[14] - from[14]) * rate,
+           rotation[0] * rate, rotation[1] * rate, rotation[2] * rate}};
+}
+
+/**
+ * Sets the given errors for the RateViolation values in violations.
+ */
+inline void setRateErrors(uint32_t violations,
+                          Error velocity_error,
+                          Error acceleration_error,
+                          Error jerk_error,
+                          ErrorSet& errors) noexcept {
+  if ((violations & kVelocityViolation) != 0) {
+    errors.set(velocity_error);
+  }
+  if ((violations & kAccelerationViolation) != 0) {
+    errors.set(acceleration_error);
+  }
+  if ((violations & kJerkViolation) != 0) {
+    errors.set(jerk_error);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Predicts the kCartesian* motion generator errors a Cartesian MotionGeneratorCommand would
+ * trigger, before it is sent.
+ *
+ * As for JointMotionChecker, the previous commands are taken from the state: O_T_EE_c, O_dP_EE_c
+ * and O_ddP_EE_c, and elbow_c, delbow_c and ddelbow_c. In Cartesian position mode the twist is the
+ * finite difference of the commanded poses, and O_T_EE_c has to be a homogeneous transform; if it
+ * is not, no rates are checked. In Cartesian velocity mode the twist is O_dP_EE_c. If the command
+ * has a valid elbow, its position, rates and sign are checked as well. Elbow rate violations are
+ * reported as the kCartesianMotionGeneratorJoint* rate errors, since the elbow is the position of
+ * joint 3. The elbow sign is compared against the measured elbow, since it cannot change during a
+ * motion.
+ */
+class CartesianMotionChecker {
+ public:
+  /**
+   * @param[in] limits Limits to check against.
+   * @param[in] period Control period, i.e. the time between two commands.
+   */
+  explicit CartesianMotionChecker(
+      const CartesianMotionLimits& limits = kDefaultCartesianMotionLimits,
+      std::chrono::nanoseconds period = std::chrono::milliseconds(1))
+      : limits_(limits), rate_(1.0 / std::chrono::duration<double>(period).count()) {}
+
+  /**
+   * @return The errors the command would trigger; empty for motion generator modes other than
+   * Cartesian position and Cartesian velocity.
+   */
+  ErrorSet check(const MotionGeneratorCommand& command, const RobotState& state) const noexcept {
+    ErrorSet errors;
+    const std::array<double, 6> previous_twist = state.O_dP_EE_c;
+    const std::array<double, 6> previous_acceleration = state.O_ddP_EE_c;
+    std::array<double, 6> twist;
+    switch (state.motion_generator_mode) {
+      case MotionGeneratorMode::kCartesianPosition:
+        if (!detail::isHomogeneousTransform(
+                reinterpret_cast<const uint8_t*>(&command) +
+                    offsetof(MotionGeneratorCommand, O_T_EE_c),
+                kTransformTolerance)) {
+          errors.set(Error::kCartesianPositionMotionGeneratorInvalidFrame);
+          // Without a valid pose there is no meaningful twist, so rates checked against it
+          // would only report follow-up errors.
+          checkElbowPosition(command, state, errors);
+          return errors;
+        }
+        twist = detail::getPoseDifference(state.O_T_EE_c, command.O_T_EE_c, rate_);
+        break;
+      case MotionGeneratorMode::kCartesianVelocity:
+        twist = command.O_dP_EE_c;
+        break;
+      default:
+        return errors;
+    }
+
+    const uint32_t violations =
+        detail::checkRates<3>(twist.data(), previous_twist.data(), previous_acceleration.data(),
+                              rate_, limits_.translational_velocity,
+                              limits_.translational_acceleration, limits_.translational_jerk) |
+        detail::checkRates<3>(twist.data() + 3, previous_twist.data() + 3,
+                              previous_acceleration.data() + 3, rate_,
+                              limits_.rotational_velocity, limits_.rotational_acceleration,
+                              limits_.rotational_jerk);
+    detail::setRateErrors(violations, Error::kCartesianMotionGeneratorVelocityLimitsViolation,
+                          Error::kCartesianMotionGeneratorVelocityDiscontinuity,
+                          Error::kCartesianMotionGeneratorAccelerationDiscontinuity, errors);
+    checkElbowPosition(command, state, errors);
+    // The elbow is the position of joint 3, so its rates are reported as joint errors.
+    detail::setRateErrors(checkElbowRates(command, state),
+                          Error::kCartesianMotionGeneratorJointVelocityLimitsViolation,
+                          Error::kCartesianMotionGeneratorJointVelocityDiscontinuity,
+                          Error::kCartesianMotionGeneratorJointAccelerationDiscontinuity, errors);
+    return errors;
+  }
+
+ private:
+  void checkElbowPosition(const MotionGeneratorCommand& command,
+                          const RobotState& state,
+                          ErrorSet& errors) const noexcept {
+    if (!command.valid_elbow) {
+      return;
+    }
+    const std::array<double, 2> elbow = command.elbow_c;
+    if (!(elbow[0] >= limits_.elbow_min && elbow[0] <= limits_.elbow_max)) {
+      errors.set(Error::kCartesianMotionGeneratorElbowLimitViolation);
+    }
+    if (!(elbow[1] * state.elbow[1] > 0.0)) {
+      errors.set(Error::kCartesianMotionGeneratorElbowSignInconsistent);
+    }
+  }
+
+  uint32_t checkElbowRates(const MotionGeneratorCommand& command,
+                           const RobotState& state) const noexcept {
+    if (!command.valid_elbow) {
+      return 0;
+    }
+    const std::array<double, 2> elbow = command.elbow_c;
+    const std::array<double, 2> previous_elbow = state.elbow_c;
+    const std::array<double, 2> previous_velocity = state.delbow_c;
+    const std::array<double, 2> previous_acceleration = state.ddelbow_c;
+    const double velocity = (elbow[0] - previous_elbow[0]) * rate_;
+    return detail::checkRates<1>(&velocity, previous_velocity.data(), previous_acceleration.data(),
+                                 rate_, limits_.elbow_velocity, limits_.elbow_acceleration,
+                                 limits_.elbow_jerk);
+  }
+
+  CartesianMotionLimits limits_;
+  double rate_;
+};
+
+}  // namespace robot
+}  // namespace research_interface
@@ -2,6 +2,9 @@
 // Use of this source code is governed by the Apache-2.0 license, see LICENSE
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 namespace research_interface {
 namespace robot {
 
@@ -49,92 +52,156 @@ enum class Error : size_t {
   kBaseAccelerationInvalidReading
 };
 
-const char* getErrorName(Error error) {
-  switch (error) {
-    case Error::kCartesianMotionGeneratorAccelerationDiscontinuity:
-      return "cartesian_motion_generator_acceleration_discontinuity";
-    case Error::kCartesianMotionGeneratorElbowLimitViolation:
-      return "cartesian_motion_generator_elbow_limit_violation";
-    case Error::kCartesianMotionGeneratorElbowSignInconsistent:
-      return "cartesian_motion_generator_elbow_sign_inconsistent";
-    case Error::kCartesianMotionGeneratorJointAccelerationDiscontinuity:
-      return "cartesian_motion_generator_joint_acceleration_discontinuity";
-    case Error::kCartesianMotionGeneratorJointPositionLimitsViolation:
-      return "cartesian_motion_generator_joint_position_limits_violation";
-    case Error::kCartesianMotionGeneratorJointVelocityDiscontinuity:
-      return "cartesian_motion_generator_joint_velocity_discontinuity";
-    case Error::kCartesianMotionGeneratorJointVelocityLimitsViolation:
-      return "cartesian_motion_generator_joint_velocity_limits_violation";
-    case Error::kCartesianMotionGeneratorStartElbowInvalid:
-      return "cartesian_motion_generator_start_elbow_invalid";
-    case Error::kCartesianMotionGeneratorVelocityDiscontinuity:
-      return "cartesian_motion_generator_velocity_discontinuity";
-    case Error::kCartesianMotionGeneratorVelocityLimitsViolation:
-      return "cartesian_motion_generator_velocity_limits_violation";
-    case Error::kCartesianPositionLimitsViolation:
-      return "cartesian_position_limits_violation";
-    case Error::kCartesianPositionMotionGeneratorInvalidFrame:
-      return "cartesian_position_motion_generator_invalid_frame_flag";
-    case Error::kCartesianPositionMotionGeneratorStartPoseInvalid:
-      return "cartesian_position_motion_generator_start_pose_invalid";
-    case Error::kCartesianReflex:
-      return "cartesian_reflex";
-    case Error::kCartesianVelocityProfileSafetyViolation:
-      return "cartesian_velocity_profile_safety_violation";
-    case Error::kCartesianVelocityViolation:
-      return "cartesian_velocity_violation";
-    case Error::kCommunicationConstraintsViolation:
-      return "communication_constraints_violation";
-    case Error::kControllerTorqueDiscontinuity:
-      return "controller_torque_discontinuity";
-    case Error::kForceControlSafetyViolation:
-      return "force_control_safety_violation";
-    case Error::kForceControllerDesiredForceToleranceViolation:
-      return "force_controller_desired_force_tolerance_violation";
-    case Error::kJointMotionGeneratorAccelerationDiscontinuity:
-      return "joint_motion_generator_acceleration_discontinuity";
-    case Error::kJointMotionGeneratorPositionLimitsViolation:
-      return "joint_motion_generator_position_limits_violation";
-    case Error::kJointMotionGeneratorVelocityDiscontinuity:
-      return "joint_motion_generator_velocity_discontinuity";
-    case Error::kJointMotionGeneratorVelocityLimitsViolation:
-      return "joint_motion_generator_velocity_limits_violation";
-    case Error::kJointPositionLimitsViolation:
-      return "joint_position_limits_violation";
-    case Error::kJointPositionMotionGeneratorStartPoseInvalid:
-      return "joint_position_motion_generator_start_pose_invalid";
-    case Error::kJointReflex:
-      return "joint_reflex";
-    case Error::kJointVelocityViolation:
-      return "joint_velocity_violation";
-    case Error::kMaxGoalPoseDeviationViolation:
-      return "max_goal_pose_deviation_violation";
-    case Error::kMaxPathPoseDeviationViolation:
-      return "max_path_pose_deviation_violation";
-    case Error::kPowerLimitViolation:
-      return "power_limit_violation";
-    case Error::kSelfcollisionAvoidanceViolation:
-      return "self_collision_avoidance_violation";
-    case Error::kStartElbowSignInconsistent:
-      return "start_elbow_sign_inconsistent";
-    case Error::kJointP2PInsufficientTorqueForPlanning:
-      return "joint_p2p_insufficient_torque_for_planning";
-    case Error::kTauJRangeViolation:
-      return "tau_J_range_violation";
-    case Error::kInstabilityDetection:
-      return "instability_detected";
-    case Error::kJointMoveInWrongDirection:
-      return "joint_move_in_wrong_direction";
-    case Error::kCartesianSplineViolation:
-      return "cartesian_spline_motion_generator_violation";
-    case Error::kJointViaPlanLimitViolation:
-      return "joint_via_motion_generator_planning_joint_limit_violation";
-    case Error::kBaseAccelerationInitializationTimeout:
-      return "base_acceleration_initialization_timeout";
-    case Error::kBaseAccelerationInvalidReading:
-      return "base_acceleration_invalid_reading";
+constexpr size_t kErrorCount = static_cast<size_t>(Error::kBaseAccelerationInvalidReading) + 1;
+
+namespace detail {
+
+constexpr const char* kErrorNames[] = {
+    "joint_position_limits_violation",
+    "cartesian_position_limits_violation",
+    "self_collision_avoidance_violation",
+    "joint_velocity_violation",
+    "cartesian_velocity_violation",
+    "force_control_safety_violation",
+    "joint_reflex",
+    "cartesian_reflex",
+    "max_goal_pose_deviation_violation",
+    "max_path_pose_deviation_violation",
+    "cartesian_velocity_profile_safety_violation",
+    "joint_position_motion_generator_start_pose_invalid",
+    "joint_motion_generator_position_limits_violation",
+    "joint_motion_generator_velocity_limits_violation",
+    "joint_motion_generator_velocity_discontinuity",
+    "joint_motion_generator_acceleration_discontinuity",
+    "cartesian_position_motion_generator_start_pose_invalid",
+    "cartesian_motion_generator_elbow_limit_violation",
+    "cartesian_motion_generator_velocity_limits_violation",
+    "cartesian_motion_generator_velocity_discontinuity",
+    "cartesian_motion_generator_acceleration_discontinuity",
+    "cartesian_motion_generator_elbow_sign_inconsistent",
+    "cartesian_motion_generator_start_elbow_invalid",
+    "force_controller_desired_force_tolerance_violation",
+    "start_elbow_sign_inconsistent",
+    "communication_constraints_violation",
+    "power_limit_violation",
+    "cartesian_motion_generator_joint_position_limits_violation",
+    "cartesian_motion_generator_joint_velocity_limits_violation",
+    "cartesian_motion_generator_joint_velocity_discontinuity",
+    "cartesian_motion_generator_joint_acceleration_discontinuity",
+    "cartesian_position_motion_generator_invalid_frame_flag",
+    "controller_torque_discontinuity",
+    "joint_p2p_insufficient_torque_for_planning",
+    "tau_J_range_violation",
+    "instability_detected",
+    "joint_move_in_wrong_direction",
+    "cartesian_spline_motion_generator_violation",
+    "joint_via_motion_generator_planning_joint_limit_violation",
+    "base_acceleration_initialization_timeout",
+    "base_acceleration_invalid_reading"
+};
+
+static_assert(sizeof(kErrorNames) / sizeof(kErrorNames[0]) == kErrorCount,
+              "kErrorNames must have one entry per Error.");
+
+constexpr size_t getStringLength(const char* string) noexcept {
+  size_t length = 0;
+  while (string[length] != '\0') {
+    length++;
+  }
+  return length;
+}
+
+constexpr bool equals(const char* a, const char* b, size_t length) noexcept {
+  for (size_t i = 0; i < length; i++) {
+    if (b[i] == '\0' || a[i] != b[i]) {
+      return false;
+    }
   }
-  throw std::logic_error("Invalid Error given.");
+  return b[length] == '\0';
+}
+
+constexpr size_t kErrorNameSlotCount = 256;
+constexpr uint8_t kEmptyErrorNameSlot = 0xFF;
+
+constexpr size_t hashErrorName(const char* name, size_t length, uint64_t seed) noexcept {
+  uint64_t hash = 14695981039346656037ull ^ seed;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= static_cast<uint8_t>(name[i]);
+    hash *= 1099511628211ull;
+  }
+  return static_cast<size_t>(hash >> 56);
+}
+
+/**
+ * Perfect hash table from error name to Error, searched for at compile time.
+ */
+struct ErrorNameTable {
+  uint64_t seed;
+  uint8_t slots[kErrorNameSlotCount];
+};
+
+constexpr ErrorNameTable makeErrorNameTable() noexcept {
+  ErrorNameTable table{0, {}};
+  for (uint64_t seed = 0;; seed++) {
+    table.seed = seed;
+    for (size_t slot = 0; slot < kErrorNameSlotCount; slot++) {
+      table.slots[slot] = kEmptyErrorNameSlot;
+    }
+    bool collision_free = true;
+    for (size_t i = 0; i < kErrorCount && collision_free; i++) {
+      size_t slot = hashErrorName(kErrorNames[i], getStringLength(kErrorNames[i]), seed);
+      collision_free = table.slots[slot] == kEmptyErrorNameSlot;
+      table.slots[slot] = static_cast<uint8_t>(i);
+    }
+    if (collision_free) {
+      return table;
+    }
+  }
+}
+
+constexpr ErrorNameTable kErrorNameTable = makeErrorNameTable();
+
+}  // namespace detail
+
+/**
+ * Returns the name of the given error, or "unknown_error" for values outside of Error.
+ */
+constexpr const char* getErrorName(Error error) noexcept {
+  return static_cast<size_t>(error) < kErrorCount
+             ? detail::kErrorNames[static_cast<size_t>(error)]
+             : "unknown_error";
+}
+
+/**
+ * Looks up an Error by its name as returned by getErrorName.
+ *
+ * @param[in] name Name, not necessarily null-terminated.
+ * @param[in] length Length of name.
+ * @param[out] error Set to the matching Error if found.
+ *
+ * @return True if an error with the given name exists.
+ */
+constexpr bool getErrorFromName(const char* name, size_t length, Error* error) noexcept {
+  const size_t slot = detail::hashErrorName(name, length, detail::kErrorNameTable.seed);
+  const uint8_t index = detail::kErrorNameTable.slots[slot];
+  if (index == detail::kEmptyErrorNameSlot ||
+      !detail::equals(name, detail::kErrorNames[index], length)) {
+    return false;
+  }
+  *error = static_cast<Error>(index);
+  return true;
+}
+
+/**
+ * Looks up an Error by its null-terminated name as returned by getErrorName.
+ *
+ * @param[in] name Null-terminated name.
+ * @param[out] error Set to the matching Error if found.
+ *
+ * @return True if an error with the given name exists.
+ */
+constexpr bool getErrorFromName(const char* name, Error* error) noexcept {
+  return getErrorFromName(name, detail::getStringLength(name), error);
 }
 
 }  // namespace robot
@@ -0,0 +1,206 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <research_interface/robot/error.h>
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace robot {
+
+static_assert(std::tuple_size<decltype(RobotState::errors)>::value == kErrorCount,
+              "RobotState::errors must have one entry per Error.");
+static_assert(std::tuple_size<decltype(RobotState::reflex_reason)>::value == kErrorCount,
+              "RobotState::reflex_reason must have one entry per Error.");
+static_assert(kErrorCount <= 64, "ErrorSet must fit into 64 bits.");
+
+namespace detail {
+
+inline int countBits(uint64_t bits) noexcept {
+#if defined(__GNUC__)
+  return __builtin_popcountll(bits);
+#else
+  int count = 0;
+  for (; bits != 0; bits &= bits - 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+inline size_t countTrailingZeros(uint64_t bits) noexcept {
+#if defined(__GNUC__)
+  return static_cast<size_t>(__builtin_ctzll(bits));
+#else
+  size_t count = 0;
+  for (; (bits & 1) == 0; bits >>= 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+/**
+ * Packs the kErrorCount booleans (each 0 or 1) starting at `data` into a bit mask.
+ */
+inline uint64_t packBools(const uint8_t* data) noexcept {
+#if defined(__AVX2__)
+  // Bytes [0, 32) and [kErrorCount - 16, kErrorCount); the overlap is shifted out.
+  const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + kErrorCount - 16));
+  const uint64_t low_bits =
+      static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_slli_epi16(low, 7)));
+  const uint64_t high_bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_slli_epi16(high, 7)));
+  return low_bits | (high_bits >> (32 - (kErrorCount - 16)) << 32);
+#elif defined(__SSE2__)
+  const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+  const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+  const __m128i third = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + kErrorCount - 16));
+  const uint64_t first_bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_slli_epi16(first, 7)));
+  const uint64_t second_bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_slli_epi16(second, 7)));
+  const uint64_t third_bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_slli_epi16(third, 7)));
+  return first_bits | (second_bits << 16) | (third_bits >> (32 - (kErrorCount - 16)) << 32);
+#else
+  uint64_t bits = 0;
+  for (size_t i = 0; i < kErrorCount; i++) {
+    bits |= static_cast<uint64_t>(data[i] != 0) << i;
+  }
+  return bits;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Set of Error values backed by a single 64-bit mask.
+ *
+ * Can be built from RobotState::errors or RobotState::reflex_reason and iterated in ascending
+ * Error order.
+ */
+class ErrorSet {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Error;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Error*;
+    using reference = Error;
+
+    constexpr explicit Iterator(uint64_t bits) noexcept : bits_(bits) {}
+
+    Error operator*() const noexcept {
+      return static_cast<Error>(detail::countTrailingZeros(bits_));
+    }
+
+    Iterator& operator++() noexcept {
+      bits_ &= bits_ - 1;
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    constexpr bool operator==(const Iterator& other) const noexcept {
+      return bits_ == other.bits_;
+    }
+    constexpr bool operator!=(const Iterator& other) const noexcept {
+      return bits_ != other.bits_;
+    }
+
+   private:
+    uint64_t bits_;
+  };
+
+  static constexpr uint64_t kMask = (uint64_t{1} << kErrorCount) - 1;
+
+  constexpr ErrorSet() noexcept = default;
+  constexpr explicit ErrorSet(uint64_t bits) noexcept : bits_(bits & kMask) {}
+  explicit ErrorSet(const std::array<bool, kErrorCount>& errors) noexcept
+      : bits_(detail::packBools(reinterpret_cast<const uint8_t*>(errors.data()))) {}
+
+  constexpr uint64_t bits() const noexcept { return bits_; }
+
+  constexpr bool any() const noexcept { return bits_ != 0; }
+  constexpr bool none() const noexcept { return bits_ == 0; }
+  size_t count() const noexcept { return static_cast<size_t>(detail::countBits(bits_)); }
+
+  constexpr bool test(Error error) const noexcept { return (bits_ & toBit(error)) != 0; }
+
+  ErrorSet& set(Error error) noexcept {
+    bits_ |= toBit(error);
+    return *this;
+  }
+
+  ErrorSet& reset(Error error) noexcept {
+    bits_ &= ~toBit(error);
+    return *this;
+  }
+
+  std::array<bool, kErrorCount> toArray() const noexcept {
+    std::array<bool, kErrorCount> errors;
+    for (size_t i = 0; i < kErrorCount; i++) {
+      errors[i] = ((bits_ >> i) & 1) != 0;
+    }
+    return errors;
+  }
+
+  Iterator begin() const noexcept { return Iterator(bits_); }
+  Iterator end() const noexcept { return Iterator(0); }
+
+  constexpr ErrorSet operator|(ErrorSet other) const noexcept {
+    return ErrorSet(bits_ | other.bits_);
+  }
+  constexpr ErrorSet operator&(ErrorSet other) const noexcept {
+    return ErrorSet(bits_ & other.bits_);
+  }
+  constexpr ErrorSet operator^(ErrorSet other) const noexcept {
+    return ErrorSet(bits_ ^ other.bits_);
+  }
+  constexpr ErrorSet operator-(ErrorSet other) const noexcept {
+    return ErrorSet(bits_ & ~other.bits_);
+  }
+  constexpr ErrorSet operator~() const noexcept { return ErrorSet(~bits_); }
+
+  ErrorSet& operator|=(ErrorSet other) noexcept {
+    bits_ |= other.bits_;
+    return *this;
+  }
+  ErrorSet& operator&=(ErrorSet other) noexcept {
+    bits_ &= other.bits_;
+    return *this;
+  }
+  ErrorSet& operator^=(ErrorSet other) noexcept {
+    bits_ ^= other.bits_;
+    return *this;
+  }
+  ErrorSet& operator-=(ErrorSet other) noexcept {
+    bits_ &= ~other.bits_;
+    return *this;
+  }
+
+  constexpr bool operator==(ErrorSet other) const noexcept { return bits_ == other.bits_; }
+  constexpr bool operator!=(ErrorSet other) const noexcept { return bits_ != other.bits_; }
+
+ private:
+  static constexpr uint64_t toBit(Error error) noexcept {
+    return uint64_t{1} << static_cast<size_t>(error);
+  }
+
+  uint64_t bits_ = 0;
+};
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,303 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <research_interface/robot/robot_state_aligned.h>
+
+namespace research_interface {
+namespace robot {
+namespace simd {
+
+/**
+ * The eight lanes of a padded joint vector, held in SIMD registers.
+ *
+ * Lets joint-space kernels be written once for AVX, SSE2 and scalar code. Joint vectors loaded
+ * from wire structs have seven joints and a zero padding lane. Lane masks only report the seven
+ * joints. The helpers live in their own namespace so that min(), max() and abs() do not hide the
+ * standard overloads in robot.
+ */
+struct JointBatch {
+#if defined(__AVX__)
+  __m256d low;
+  __m256d high;
+#elif defined(__SSE2__)
+  __m128d lanes[4];
+#else
+  double lanes[kPaddedJointCount];
+#endif
+};
+
+/// Mask of the lanes holding joints in the results of greaterMask().
+constexpr uint32_t kJointLaneMask = (1u << kJointCount) - 1;
+
+inline JointBatch broadcast(double value) noexcept {
+#if defined(__AVX__)
+  return {_mm256_set1_pd(value), _mm256_set1_pd(value)};
+#elif defined(__SSE2__)
+  const __m128d lanes = _mm_set1_pd(value);
+  return {{lanes, lanes, lanes, lanes}};
+#else
+  JointBatch batch;
+  for (double& lane : batch.lanes) {
+    lane = value;
+  }
+  return batch;
+#endif
+}
+
+/**
+ * Loads all eight lanes with aligned loads.
+ */
+inline JointBatch load(const AlignedJointVector& vector) noexcept {
+#if defined(__AVX__)
+  return {_mm256_load_pd(vector.data()), _mm256_load_pd(vector.data() + 4)};
+#elif defined(__SSE2__)
+  return {{_mm_load_pd(vector.data()), _mm_load_pd(vector.data() + 2),
+           _mm_load_pd(vector.data() + 4), _mm_load_pd(vector.data() + 6)}};
+#else
+  JointBatch batch;
+  std::memcpy(batch.lanes, vector.data(), sizeof(batch.lanes));
+  return batch;
+#endif
+}
+
+/**
+ * Stores all eight lanes with aligned stores.
+ */
+inline void store(const JointBatch& batch, AlignedJointVector& vector) noexcept {
+#if defined(__AVX__)
+  _mm256_store_pd(vector.data(), batch.low);
+  _mm256_store_pd(vector.data() + 4, batch.high);
+#elif defined(__SSE2__)
+  for (size_t i = 0; i < 4; i++) {
+    _mm_store_pd(vector.data() + 2 * i, batch.lanes[i]);
+  }
+#else
+  std::memcpy(vector.data(), batch.lanes, sizeof(batch.lanes));
+#endif
+}
+
+#if defined(__SSE2__)
+namespace detail {
+
+// Counterpart of loadLastJoint(); _mm_store_sd() would require an aligned double.
+inline void storeLastJoint(double* destination, __m128d value) noexcept {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(destination), _mm_castpd_si128(value));
+}
+
+}  // namespace detail
+#endif
+
+/**
+ * Loads the kJointCount doubles of a packed wire field; the padding lane is zero.
+ */
+inline JointBatch loadJoints(const uint8_t* data) noexcept {
+  const double* src = reinterpret_cast<const double*>(data);
+#if defined(__AVX__)
+  return {_mm256_loadu_pd(src),
+          _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(src + 4)),
+                               robot::detail::loadLastJoint(src + 6), 1)};
+#elif defined(__SSE2__)
+  return {{_mm_loadu_pd(src), _mm_loadu_pd(src + 2), _mm_loadu_pd(src + 4),
+           robot::detail::loadLastJoint(src + 6)}};
+#else
+  JointBatch batch;
+  std::memcpy(batch.lanes, src, kJointCount * sizeof(double));
+  batch.lanes[kJointCount] = 0.0;
+  return batch;
+#endif
+}
+
+/**
+ * Stores the kJointCount joints into a packed wire field.
+ */
+inline void storeJoints(const JointBatch& batch, uint8_t* data) noexcept {
+  double* dst = reinterpret_cast<double*>(data);
+#if defined(__AVX__)
+  _mm256_storeu_pd(dst, batch.low);
+  _mm_storeu_pd(dst + 4, _mm256_castpd256_pd128(batch.high));
+  detail::storeLastJoint(dst + 6, _mm256_extractf128_pd(batch.high, 1));
+#elif defined(__SSE2__)
+  _mm_storeu_pd(dst, batch.lanes[0]);
+  _mm_storeu_pd(dst + 2, batch.lanes[1]);
+  _mm_storeu_pd(dst + 4, batch.lanes[2]);
+  detail::storeLastJoint(dst + 6, batch.lanes[3]);
+#else
+  std::memcpy(dst, batch.lanes, kJointCount * sizeof(double));
+#endif
+}
+
+namespace detail {
+
+#if defined(__AVX__)
+using JointRegister = __m256d;
+#elif defined(__SSE2__)
+using JointRegister = __m128d;
+#else
+using JointRegister = double;
+#endif
+
+/**
+ * Applies op to corresponding registers (or lanes, for scalar code) of a and b.
+ */
+template <typename Op>
+inline JointBatch transform(const JointBatch& a, const JointBatch& b, Op op) noexcept {
+#if defined(__AVX__)
+  return {op(a.low, b.low), op(a.high, b.high)};
+#elif defined(__SSE2__)
+  return {{op(a.lanes[0], b.lanes[0]), op(a.lanes[1], b.lanes[1]), op(a.lanes[2], b.lanes[2]),
+           op(a.lanes[3], b.lanes[3])}};
+#else
+  JointBatch result;
+  for (size_t i = 0; i < kPaddedJointCount; i++) {
+    result.lanes[i] = op(a.lanes[i], b.lanes[i]);
+  }
+  return result;
+#endif
+}
+
+}  // namespace detail
+
+inline JointBatch operator+(const JointBatch& a, const JointBatch& b) noexcept {
+  return detail::transform(a, b, [](detail::JointRegister x, detail::JointRegister y) {
+#if defined(__AVX__)
+    return _mm256_add_pd(x, y);
+#elif defined(__SSE2__)
+    return _mm_add_pd(x, y);
+#else
+    return x + y;
+#endif
+  });
+}
+
+inline JointBatch operator-(const JointBatch& a, const JointBatch& b) noexcept {
+  return detail::transform(a, b, [](detail::JointRegister x, detail::JointRegister y) {
+#if defined(__AVX__)
+    return _mm256_sub_pd(x, y);
+#elif defined(__SSE2__)
+    return _mm_sub_pd(x, y);
+#else
+    return x - y;
+#endif
+  });
+}
+
+inline JointBatch operator*(const JointBatch& a, const JointBatch& b) noexcept {
+  return detail::transform(a, b, [](detail::JointRegister x, detail::JointRegister y) {
+#if defined(__AVX__)
+    return _mm256_mul_pd(x, y);
+#elif defined(__SSE2__)
+    return _mm_mul_pd(x, y);
+#else
+    return x * y;
+#endif
+  });
+}
+
+/**
+ * Lane-wise minimum. Like the instruction, returns the lane of b if either lane is NaN.
+ */
+inline JointBatch min(const JointBatch& a, const JointBatch& b) noexcept {
+  return detail::transform(a, b, [](detail::JointRegister x, detail::JointRegister y) {
+#if defined(__AVX__)
+    return _mm256_min_pd(x, y);
+#elif defined(__SSE2__)
+    return _mm_min_pd(x, y);
+#else
+    return x < y ? x : y;
+#endif
+  });
+}
+
+/**
+ * Lane-wise maximum. Like the instruction, returns the lane of b if either lane is NaN.
+ */
+inline JointBatch max(const JointBatch& a, const JointBatch& b) noexcept {
+  return detail::transform(a, b, [](detail::JointRegister x, detail::JointRegister y) {
+#if defined(__AVX__)
+    return _mm256_max_pd(x, y);
+#elif defined(__SSE2__)
+    return _mm_max_pd(x, y);
+#else
+    return x > y ? x : y;
+#endif
+  });
+}
+
+inline JointBatch abs(const JointBatch& batch) noexcept {
+#if defined(__AVX__)
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  return {_mm256_andnot_pd(sign, batch.low), _mm256_andnot_pd(sign, batch.high)};
+#elif defined(__SSE2__)
+  const __m128d sign = _mm_set1_pd(-0.0);
+  return {{_mm_andnot_pd(sign, batch.lanes[0]), _mm_andnot_pd(sign, batch.lanes[1]),
+           _mm_andnot_pd(sign, batch.lanes[2]), _mm_andnot_pd(sign, batch.lanes[3])}};
+#else
+  JointBatch result;
+  for (size_t i = 0; i < kPaddedJointCount; i++) {
+    result.lanes[i] = batch.lanes[i] < 0.0 ? -batch.lanes[i] : batch.lanes[i];
+  }
+  return result;
+#endif
+}
+
+/**
+ * Limits every lane to [lower, upper]. NaN lanes become lower.
+ */
+inline JointBatch clamp(const JointBatch& batch,
+                        const JointBatch& lower,
+                        const JointBatch& upper) noexcept {
+  return min(max(batch, lower), upper);
+}
+
+/**
+ * Replaces the NaN lanes of batch by the corresponding lanes of replacement.
+ */
+inline JointBatch replaceNaN(const JointBatch& batch, const JointBatch& replacement) noexcept {
+  return detail::transform(batch, replacement, [](detail::JointRegister x,
+                                                  detail::JointRegister y) {
+#if defined(__AVX__)
+    return _mm256_blendv_pd(x, y, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+#elif defined(__SSE2__)
+    const __m128d nan = _mm_cmpunord_pd(x, x);
+    return _mm_or_pd(_mm_and_pd(nan, y), _mm_andnot_pd(nan, x));
+#else
+    return x != x ? y : x;
+#endif
+  });
+}
+
+/**
+ * Bit i is set if joint i of a is greater than joint i of b, or either of them is NaN.
+ */
+inline uint32_t greaterMask(const JointBatch& a, const JointBatch& b) noexcept {
+#if defined(__AVX__)
+  const int low = _mm256_movemask_pd(_mm256_cmp_pd(a.low, b.low, _CMP_NLE_UQ));
+  const int high = _mm256_movemask_pd(_mm256_cmp_pd(a.high, b.high, _CMP_NLE_UQ));
+  return static_cast<uint32_t>(low | high << 4) & kJointLaneMask;
+#elif defined(__SSE2__)
+  int mask = 0;
+  for (int i = 0; i < 4; i++) {
+    mask |= _mm_movemask_pd(_mm_cmpnle_pd(a.lanes[i], b.lanes[i])) << (2 * i);
+  }
+  return static_cast<uint32_t>(mask) & kJointLaneMask;
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kJointCount; i++) {
+    mask |= static_cast<uint32_t>(!(a.lanes[i] <= b.lanes[i])) << i;
+  }
+  return mask;
+#endif
+}
+
+}  // namespace simd
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,84 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace robot {
+
+/**
+ * Example gains for computeJointImpedanceTorques(), which reads stiffness() and damping() at
+ * compile time.
+ */
+struct DefaultJointImpedanceGains {
+  /// Stiffness in Nm/rad.
+  static constexpr std::array<double, 7> stiffness() noexcept {
+    return {{600.0, 600.0, 600.0, 600.0, 250.0, 150.0, 50.0}};
+  }
+
+  /// Damping in Nms/rad.
+  static constexpr std::array<double, 7> damping() noexcept {
+    return {{50.0, 50.0, 50.0, 50.0, 30.0, 25.0, 15.0}};
+  }
+};
+
+namespace detail {
+
+template <typename Gains>
+inline std::array<double, 7> computeJointImpedanceTorques(const RobotState& state) noexcept {
+  static constexpr std::array<double, 7> kStiffness = Gains::stiffness();
+  static constexpr std::array<double, 7> kDamping = Gains::damping();
+  // Copies out of the packed struct, so that the loop works on aligned locals.
+  const std::array<double, 7> q = state.q;
+  const std::array<double, 7> q_d = state.q_d;
+  const std::array<double, 7> dq = state.dq;
+  const std::array<double, 7> dq_d = state.dq_d;
+  std::array<double, 7> tau_J_d;
+  for (size_t i = 0; i < tau_J_d.size(); i++) {
+    tau_J_d[i] = kStiffness[i] * (q_d[i] - q[i]) + kDamping[i] * (dq_d[i] - dq[i]);
+  }
+  return tau_J_d;
+}
+
+}  // namespace detail
+
+/**
+ * Reference joint impedance controller:
+ * tau_J_d = K * (q_d - q) + D * (dq_d - dq) + feedforward.
+ *
+ * The gains are compile-time constants, so the per-joint loop is vectorized with constant
+ * operands. The torques are written to command.control.tau_J_d, and command.message_id is set to
+ * the one of the state; the motion generator part of the command is left unchanged.
+ *
+ * @tparam Gains Gain set, see DefaultJointImpedanceGains.
+ * @param[in] state Current state.
+ * @param[in] feedforward Feedforward torques, e.g. Coriolis compensation.
+ * @param[out] command Command to fill.
+ */
+template <typename Gains = DefaultJointImpedanceGains>
+inline void computeJointImpedanceTorques(const RobotState& state,
+                                         const std::array<double, 7>& feedforward,
+                                         RobotCommand& command) noexcept {
+  std::array<double, 7> tau_J_d = detail::computeJointImpedanceTorques<Gains>(state);
+  for (size_t i = 0; i < tau_J_d.size(); i++) {
+    tau_J_d[i] += feedforward[i];
+  }
+  command.message_id = state.message_id;
+  command.control.tau_J_d = tau_J_d;
+}
+
+/**
+ * Reference joint impedance controller without feedforward torques, see above.
+ */
+template <typename Gains = DefaultJointImpedanceGains>
+inline void computeJointImpedanceTorques(const RobotState& state, RobotCommand& command) noexcept {
+  command.message_id = state.message_id;
+  command.control.tau_J_d = detail::computeJointImpedanceTorques<Gains>(state);
+}
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,129 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <research_interface/robot/error.h>
+#include <research_interface/robot/error_set.h>
+#include <research_interface/robot/joint_batch.h>
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/robot_state_aligned.h>
+
+namespace research_interface {
+namespace robot {
+
+/**
+ * Joint limits a joint motion generator has to respect.
+ */
+struct JointMotionLimits {
+  std::array<double, 7> q_min;
+  std::array<double, 7> q_max;
+  std::array<double, 7> dq_max;
+  std::array<double, 7> ddq_max;
+  std::array<double, 7> dddq_max;
+};
+
+/// Limits from the Panda datasheet.
+constexpr JointMotionLimits kDefaultJointMotionLimits{
+    {{-2.8973, -1.7628, -2.8973, -3.0718, -2.8973, -0.0175, -2.8973}},
+    {{2.8973, 1.7628, 2.8973, -0.0698, 2.8973, 3.7525, 2.8973}},
+    {{2.1750, 2.1750, 2.1750, 2.1750, 2.6100, 2.6100, 2.6100}},
+    {{15.0, 7.5, 10.0, 12.5, 15.0, 20.0, 20.0}},
+    {{7500.0, 3750.0, 5000.0, 6250.0, 7500.0, 10000.0, 10000.0}}};
+
+/**
+ * Checks a joint MotionGeneratorCommand before it is sent, to catch commands the robot would
+ * reject.
+ *
+ * The previous commands are taken from the state: q_d, dq_d and ddq_d are the last commanded
+ * position, velocity and acceleration. In joint position mode the velocity, acceleration and jerk
+ * of the command are finite differences of q_c; in joint velocity mode they are derived from
+ * dq_c. The motion generator mode is taken from the state as well. All joints are checked at
+ * once with SIMD code.
+ */
+class JointMotionChecker {
+ public:
+  /**
+   * @param[in] limits Limits to check against.
+   * @param[in] period Control period, i.e. the time between two commands.
+   */
+  explicit JointMotionChecker(const JointMotionLimits& limits = kDefaultJointMotionLimits,
+                              std::chrono::nanoseconds period = std::chrono::milliseconds(1))
+      : period_(std::chrono::duration<double>(period).count()) {
+    copy(limits.q_min, q_min_);
+    copy(limits.q_max, q_max_);
+    copy(limits.dq_max, dq_max_);
+    copy(limits.ddq_max, ddq_max_);
+    copy(limits.dddq_max, dddq_max_);
+  }
+
+  /**
+   * @return The kJointMotionGenerator* errors the command would trigger; empty for motion
+   * generator modes other than joint position and joint velocity. NaNs are reported as
+   * violations.
+   */
+  ErrorSet check(const MotionGeneratorCommand& command, const RobotState& state) const noexcept {
+    const uint8_t* command_data = reinterpret_cast<const uint8_t*>(&command);
+    const uint8_t* state_data = reinterpret_cast<const uint8_t*>(&state);
+    const simd::JointBatch period = simd::broadcast(period_);
+    const simd::JointBatch rate = simd::broadcast(1.0 / period_);
+    const simd::JointBatch q_d = simd::loadJoints(state_data + offsetof(RobotState, q_d));
+
+    simd::JointBatch q_c;
+    simd::JointBatch dq_c;
+    switch (state.motion_generator_mode) {
+      case MotionGeneratorMode::kJointPosition:
+        q_c = simd::loadJoints(command_data + offsetof(MotionGeneratorCommand, q_c));
+        dq_c = (q_c - q_d) * rate;
+        break;
+      case MotionGeneratorMode::kJointVelocity:
+        dq_c = simd::loadJoints(command_data + offsetof(MotionGeneratorCommand, dq_c));
+        q_c = q_d + dq_c * period;
+        break;
+      default:
+        return ErrorSet();
+    }
+    const simd::JointBatch ddq_c =
+        (dq_c - simd::loadJoints(state_data + offsetof(RobotState, dq_d))) * rate;
+    const simd::JointBatch dddq_c =
+        (ddq_c - simd::loadJoints(state_data + offsetof(RobotState, ddq_d))) * rate;
+
+    ErrorSet errors;
+    if ((simd::greaterMask(simd::load(q_min_), q_c) |
+         simd::greaterMask(q_c, simd::load(q_max_))) != 0) {
+      errors.set(Error::kJointMotionGeneratorPositionLimitsViolation);
+    }
+    if (simd::greaterMask(simd::abs(dq_c), simd::load(dq_max_)) != 0) {
+      errors.set(Error::kJointMotionGeneratorVelocityLimitsViolation);
+    }
+    if (simd::greaterMask(simd::abs(ddq_c), simd::load(ddq_max_)) != 0) {
+      errors.set(Error::kJointMotionGeneratorVelocityDiscontinuity);
+    }
+    if (simd::greaterMask(simd::abs(dddq_c), simd::load(dddq_max_)) != 0) {
+      errors.set(Error::kJointMotionGeneratorAccelerationDiscontinuity);
+    }
+    return errors;
+  }
+
+ private:
+  static void copy(const std::array<double, 7>& source, AlignedJointVector& destination) noexcept {
+    for (size_t i = 0; i < kJointCount; i++) {
+      destination[i] = source[i];
+    }
+    destination[kJointCount] = 0.0;
+  }
+
+  double period_;
+  AlignedJointVector q_min_;
+  AlignedJointVector q_max_;
+  AlignedJointVector dq_max_;
+  AlignedJointVector ddq_max_;
+  AlignedJointVector dddq_max_;
+};
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,17 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <research_interface/message_parser.h>
+#include <research_interface/robot/service_traits.h>
+
+namespace research_interface {
+namespace robot {
+
+/// Parses the request stream, as received by the robot.
+using RequestParser = MessageParser<Registry, MessageKind::kRequest>;
+/// Parses the response stream, as received by the client.
+using ResponseParser = MessageParser<Registry, MessageKind::kResponse>;
+
+}  // namespace robot
+}  // namespace research_interface
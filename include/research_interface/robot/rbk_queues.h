@@ -0,0 +1,35 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <cstddef>
+
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/spsc_queue.h>
+#include <research_interface/triple_buffer.h>
+
+namespace research_interface {
+namespace robot {
+
+/**
+ * Queue between the thread receiving robot states and a single consumer.
+ */
+template <size_t Capacity = 64>
+using RobotStateQueue = SpscQueue<RobotState, Capacity>;
+
+/**
+ * Queue between a single controller thread and the thread sending robot commands.
+ */
+template <size_t Capacity = 64>
+using RobotCommandQueue = SpscQueue<RobotCommand, Capacity>;
+
+/**
+ * Hands the latest RobotCommand from the controller thread to the sending thread.
+ *
+ * The controller fills writeBuffer(), including the message_id of the RobotState it answers,
+ * and calls publish(). overwrittenCount() counts commands that were never sent.
+ */
+using RobotCommandBuffer = TripleBuffer<RobotCommand>;
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,102 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <research_interface/field_descriptor.h>
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace robot {
+
+constexpr std::array<FieldDescriptor, 46> kRobotStateFields{{
+    RESEARCH_INTERFACE_FIELD(RobotState, message_id),
+    RESEARCH_INTERFACE_FIELD(RobotState, O_T_EE),
+    RESEARCH_INTERFACE_FIELD(RobotState, O_T_EE_d),
+    RESEARCH_INTERFACE_FIELD(RobotState, F_T_EE),
+    RESEARCH_INTERFACE_FIELD(RobotState, EE_T_K),
+    RESEARCH_INTERFACE_FIELD(RobotState, F_T_NE),
+    RESEARCH_INTERFACE_FIELD(RobotState, NE_T_EE),
+    RESEARCH_INTERFACE_FIELD(RobotState, m_ee),
+    RESEARCH_INTERFACE_FIELD(RobotState, I_ee),
+    RESEARCH_INTERFACE_FIELD(RobotState, F_x_Cee),
+    RESEARCH_INTERFACE_FIELD(RobotState, m_load),
+    RESEARCH_INTERFACE_FIELD(RobotState, I_load),
+    RESEARCH_INTERFACE_FIELD(RobotState, F_x_Cload),
+    RESEARCH_INTERFACE_FIELD(RobotState, elbow),
+    RESEARCH_INTERFACE_FIELD(RobotState, elbow_d),
+    RESEARCH_INTERFACE_FIELD(RobotState, tau_J),
+    RESEARCH_INTERFACE_FIELD(RobotState, tau_J_d),
+    RESEARCH_INTERFACE_FIELD(RobotState, dtau_J),
+    RESEARCH_INTERFACE_FIELD(RobotState, q),
+    RESEARCH_INTERFACE_FIELD(RobotState, q_d),
+    RESEARCH_INTERFACE_FIELD(RobotState, dq),
+    RESEARCH_INTERFACE_FIELD(RobotState, dq_d),
+    RESEARCH_INTERFACE_FIELD(RobotState, ddq_d),
+    RESEARCH_INTERFACE_FIELD(RobotState, joint_contact),
+    RESEARCH_INTERFACE_FIELD(RobotState, cartesian_contact),
+    RESEARCH_INTERFACE_FIELD(RobotState, joint_collision),
+    RESEARCH_INTERFACE_FIELD(RobotState, cartesian_collision),
+    RESEARCH_INTERFACE_FIELD(RobotState, tau_ext_hat_filtered),
+    RESEARCH_INTERFACE_FIELD(RobotState, O_F_ext_hat_K),
+    RESEARCH_INTERFACE_FIELD(RobotState, K_F_ext_hat_K),
+    RESEARCH_INTERFACE_FIELD(RobotState, O_dP_EE_d),
+    RESEARCH_INTERFACE_FIELD(RobotState, O_ddP_O),
+    RESEARCH_INTERFACE_FIELD(RobotState, elbow_c),
+    RESEARCH_INTERFACE_FIELD(RobotState, delbow_c),
+    RESEARCH_INTERFACE_FIELD(RobotState, ddelbow_c),
+    RESEARCH_INTERFACE_FIELD(RobotState, O_T_EE_c),
+    RESEARCH_INTERFACE_FIELD(RobotState, O_dP_EE_c),
+    RESEARCH_INTERFACE_FIELD(RobotState, O_ddP_EE_c),
+    RESEARCH_INTERFACE_FIELD(RobotState, theta),
+    RESEARCH_INTERFACE_FIELD(RobotState, dtheta),
+    RESEARCH_INTERFACE_FIELD(RobotState, motion_generator_mode),
+    RESEARCH_INTERFACE_FIELD(RobotState, controller_mode),
+    RESEARCH_INTERFACE_FIELD(RobotState, errors),
+    RESEARCH_INTERFACE_FIELD(RobotState, reflex_reason),
+    RESEARCH_INTERFACE_FIELD(RobotState, robot_mode),
+    RESEARCH_INTERFACE_FIELD(RobotState, control_command_success_rate)
+}};
+
+static_assert(coversExactly(kRobotStateFields, sizeof(RobotState)),
+              "kRobotStateFields must cover RobotState exactly.");
+
+constexpr std::array<FieldDescriptor, 7> kMotionGeneratorCommandFields{{
+    RESEARCH_INTERFACE_FIELD(MotionGeneratorCommand, q_c),
+    RESEARCH_INTERFACE_FIELD(MotionGeneratorCommand, dq_c),
+    RESEARCH_INTERFACE_FIELD(MotionGeneratorCommand, O_T_EE_c),
+    RESEARCH_INTERFACE_FIELD(MotionGeneratorCommand, O_dP_EE_c),
+    RESEARCH_INTERFACE_FIELD(MotionGeneratorCommand, elbow_c),
+    RESEARCH_INTERFACE_FIELD(MotionGeneratorCommand, valid_elbow),
+    RESEARCH_INTERFACE_FIELD(MotionGeneratorCommand, motion_generation_finished)
+}};
+
+static_assert(coversExactly(kMotionGeneratorCommandFields, sizeof(MotionGeneratorCommand)),
+              "kMotionGeneratorCommandFields must cover MotionGeneratorCommand exactly.");
+
+constexpr std::array<FieldDescriptor, 1> kControllerCommandFields{{
+    RESEARCH_INTERFACE_FIELD(ControllerCommand, tau_J_d)
+}};
+
+static_assert(coversExactly(kControllerCommandFields, sizeof(ControllerCommand)),
+              "kControllerCommandFields must cover ControllerCommand exactly.");
+
+constexpr std::array<FieldDescriptor, 9> kRobotCommandFields{{
+    RESEARCH_INTERFACE_FIELD(RobotCommand, message_id),
+    RESEARCH_INTERFACE_FIELD(RobotCommand, motion.q_c),
+    RESEARCH_INTERFACE_FIELD(RobotCommand, motion.dq_c),
+    RESEARCH_INTERFACE_FIELD(RobotCommand, motion.O_T_EE_c),
+    RESEARCH_INTERFACE_FIELD(RobotCommand, motion.O_dP_EE_c),
+    RESEARCH_INTERFACE_FIELD(RobotCommand, motion.elbow_c),
+    RESEARCH_INTERFACE_FIELD(RobotCommand, motion.valid_elbow),
+    RESEARCH_INTERFACE_FIELD(RobotCommand, motion.motion_generation_finished),
+    RESEARCH_INTERFACE_FIELD(RobotCommand, control.tau_J_d)
+}};
+
+static_assert(coversExactly(kRobotCommandFields, sizeof(RobotCommand)),
+              "kRobotCommandFields must cover RobotCommand exactly.");
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,129 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace robot {
+
+constexpr size_t kJointCount = 7;
+constexpr size_t kPaddedJointCount = 8;
+
+/**
+ * Joint vector padded to a full cache line and aligned to it, so that it can be read with aligned
+ * vector loads. The padding lane is always zero.
+ */
+struct alignas(64) AlignedJointVector {
+  double& operator[](size_t index) noexcept { return lanes[index]; }
+  constexpr const double& operator[](size_t index) const noexcept { return lanes[index]; }
+
+  double* data() noexcept { return lanes; }
+  constexpr const double* data() const noexcept { return lanes; }
+
+  static constexpr size_t size() noexcept { return kPaddedJointCount; }
+
+  double lanes[kPaddedJointCount];
+};
+
+static_assert(sizeof(AlignedJointVector) == 64, "AlignedJointVector must fill a cache line.");
+static_assert(alignof(AlignedJointVector) == 64,
+              "AlignedJointVector must start on a cache line.");
+
+/**
+ * Host-side mirror of the joint vectors of a RobotState.
+ *
+ * Unlike the packed wire struct, every vector is an AlignedJointVector, so consumers can use
+ * aligned vector loads over whole joint vectors.
+ */
+struct alignas(64) RobotStateAligned {
+  uint64_t message_id;
+  AlignedJointVector tau_J;
+  AlignedJointVector tau_J_d;
+  AlignedJointVector dtau_J;
+  AlignedJointVector q;
+  AlignedJointVector q_d;
+  AlignedJointVector dq;
+  AlignedJointVector dq_d;
+  AlignedJointVector ddq_d;
+  AlignedJointVector joint_contact;
+  AlignedJointVector joint_collision;
+  AlignedJointVector tau_ext_hat_filtered;
+  AlignedJointVector theta;
+  AlignedJointVector dtheta;
+};
+
+namespace detail {
+
+#if defined(__SSE2__)
+// _mm_load_sd() requires an aligned double; _mm_loadl_epi64() loads the 64 bits unaligned.
+inline __m128d loadLastJoint(const double* source) noexcept {
+  return _mm_castsi128_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)));
+}
+#endif
+
+inline void unpackJointVector(const uint8_t* source, AlignedJointVector& destination) noexcept {
+  const double* src = reinterpret_cast<const double*>(source);
+  double* dst = destination.data();
+#if defined(__AVX__)
+  _mm256_store_pd(dst, _mm256_loadu_pd(src));
+  _mm_store_pd(dst + 4, _mm_loadu_pd(src + 4));
+  _mm_store_pd(dst + 6, loadLastJoint(src + 6));
+#elif defined(__SSE2__)
+  _mm_store_pd(dst, _mm_loadu_pd(src));
+  _mm_store_pd(dst + 2, _mm_loadu_pd(src + 2));
+  _mm_store_pd(dst + 4, _mm_loadu_pd(src + 4));
+  _mm_store_pd(dst + 6, loadLastJoint(src + 6));
+#else
+  std::memcpy(dst, src, kJointCount * sizeof(double));
+  dst[kJointCount] = 0.0;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Unpacks the joint vectors of a RobotState from its wire representation.
+ *
+ * @param[in] data Start of a RobotState in a buffer of any alignment.
+ * @param[out] aligned Destination.
+ */
+inline void unpack(const uint8_t* data, RobotStateAligned& aligned) noexcept {
+  std::memcpy(&aligned.message_id, data + offsetof(RobotState, message_id),
+              sizeof(aligned.message_id));
+  detail::unpackJointVector(data + offsetof(RobotState, tau_J), aligned.tau_J);
+  detail::unpackJointVector(data + offsetof(RobotState, tau_J_d), aligned.tau_J_d);
+  detail::unpackJointVector(data + offsetof(RobotState, dtau_J), aligned.dtau_J);
+  detail::unpackJointVector(data + offsetof(RobotState, q), aligned.q);
+  detail::unpackJointVector(data + offsetof(RobotState, q_d), aligned.q_d);
+  detail::unpackJointVector(data + offsetof(RobotState, dq), aligned.dq);
+  detail::unpackJointVector(data + offsetof(RobotState, dq_d), aligned.dq_d);
+  detail::unpackJointVector(data + offsetof(RobotState, ddq_d), aligned.ddq_d);
+  detail::unpackJointVector(data + offsetof(RobotState, joint_contact), aligned.joint_contact);
+  detail::unpackJointVector(data + offsetof(RobotState, joint_collision), aligned.joint_collision);
+  detail::unpackJointVector(data + offsetof(RobotState, tau_ext_hat_filtered),
+                            aligned.tau_ext_hat_filtered);
+  detail::unpackJointVector(data + offsetof(RobotState, theta), aligned.theta);
+  detail::unpackJointVector(data + offsetof(RobotState, dtheta), aligned.dtheta);
+}
+
+/**
+ * Unpacks the joint vectors of a RobotState.
+ *
+ * @param[in] state Wire struct.
+ * @param[out] aligned Destination.
+ */
+inline void unpack(const RobotState& state, RobotStateAligned& aligned) noexcept {
+  unpack(reinterpret_cast<const uint8_t*>(&state), aligned);
+}
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,192 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <research_interface/codec.h>
+#include <research_interface/field_descriptor.h>
+#include <research_interface/robot/rbk_type_fields.h>
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace robot {
+
+static_assert(kRobotStateFields.size() <= 64, "Field masks must fit into 64 bits.");
+
+/// Default tolerance for the orthonormality of homogeneous transforms.
+constexpr double kTransformTolerance = 1e-6;
+
+/**
+ * Bit of the RobotState field at the given offset in the masks returned by
+ * validateRobotState(), e.g. `getRobotStateFieldMask(offsetof(RobotState, q))`. Bit i
+ * corresponds to kRobotStateFields[i].
+ */
+constexpr uint64_t getRobotStateFieldMask(size_t offset) noexcept {
+  for (size_t i = 0; i < kRobotStateFields.size(); i++) {
+    if (kRobotStateFields[i].offset == offset) {
+      return uint64_t{1} << i;
+    }
+  }
+  return 0;
+}
+
+namespace detail {
+
+// All doubles of a RobotState except control_command_success_rate form one contiguous block.
+constexpr size_t kStateDoublesBegin = offsetof(RobotState, O_T_EE);
+constexpr size_t kStateDoublesEnd = offsetof(RobotState, motion_generator_mode);
+constexpr size_t kStateDoubleCount = (kStateDoublesEnd - kStateDoublesBegin) / sizeof(double);
+
+constexpr bool hasOnlyDoubles(size_t begin, size_t end) noexcept {
+  for (size_t i = 0; i < kRobotStateFields.size(); i++) {
+    const FieldDescriptor& field = kRobotStateFields[i];
+    if (field.offset >= begin && field.offset < end && field.type != FieldType::kDouble) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(hasOnlyDoubles(kStateDoublesBegin, kStateDoublesEnd),
+              "RobotState doubles must be contiguous.");
+
+/**
+ * Checks whether all `count` doubles starting at `data` are finite.
+ *
+ * x - x is +0 for finite x and NaN for infinities and NaNs, so OR-ing the differences yields zero
+ * exactly if all values are finite. Requires IEEE 754 semantics, i.e. no -ffast-math.
+ */
+inline bool areFinite(const uint8_t* data, size_t count) noexcept {
+  const double* values = reinterpret_cast<const double*>(data);
+  size_t i = 0;
+#if defined(__AVX__)
+  __m256d accumulator = _mm256_setzero_pd();
+  for (; i + 4 <= count; i += 4) {
+    const __m256d x = _mm256_loadu_pd(values + i);
+    accumulator = _mm256_or_pd(accumulator, _mm256_sub_pd(x, x));
+  }
+  __m128d accumulator_sse =
+      _mm_or_pd(_mm256_castpd256_pd128(accumulator), _mm256_extractf128_pd(accumulator, 1));
+#elif defined(__SSE2__)
+  __m128d accumulator_sse = _mm_setzero_pd();
+#endif
+#if defined(__AVX__) || defined(__SSE2__)
+  for (; i + 2 <= count; i += 2) {
+    const __m128d x = _mm_loadu_pd(values + i);
+    accumulator_sse = _mm_or_pd(accumulator_sse, _mm_sub_pd(x, x));
+  }
+  if (i < count) {
+    // Not _mm_load_sd(), which requires an aligned double.
+    const __m128d x =
+        _mm_castsi128_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values + i)));
+    accumulator_sse = _mm_or_pd(accumulator_sse, _mm_sub_pd(x, x));
+  }
+  return _mm_movemask_pd(_mm_cmpunord_pd(accumulator_sse, accumulator_sse)) == 0;
+#else
+  bool finite = true;
+  for (; i < count; i++) {
+    double value;
+    std::memcpy(&value, values + i, sizeof(value));
+    finite &= std::isfinite(value);
+  }
+  return finite;
+#endif
+}
+
+/**
+ * Slow path after areFinite() failed: finds the fields holding non-finite values.
+ */
+inline uint64_t findNonFiniteFields(const uint8_t* data) noexcept {
+  uint64_t mask = 0;
+  for (size_t i = 0; i < kRobotStateFields.size(); i++) {
+    const FieldDescriptor& field = kRobotStateFields[i];
+    if (field.type != FieldType::kDouble) {
+      continue;
+    }
+    for (size_t j = 0; j < field.count; j++) {
+      if (!std::isfinite(loadUnaligned<double>(data + field.offset + j * sizeof(double)))) {
+        mask |= uint64_t{1} << i;
+        break;
+      }
+    }
+  }
+  return mask;
+}
+
+inline bool isNear(double value, double expected, double tolerance) noexcept {
+  // Written so that NaN fails.
+  return std::abs(value - expected) <= tolerance;
+}
+
+/**
+ * Checks that the column-major 4x4 matrix at data is a homogeneous transform: last row
+ * (0, 0, 0, 1) and a rotation with orthonormal columns and determinant 1.
+ */
+inline bool isHomogeneousTransform(const uint8_t* data, double tolerance) noexcept {
+  const std::array<double, 16> m = loadUnaligned<std::array<double, 16>>(data);
+  if (!isNear(m[3], 0.0, tolerance) || !isNear(m[7], 0.0, tolerance) ||
+      !isNear(m[11], 0.0, tolerance) || !isNear(m[15], 1.0, tolerance)) {
+    return false;
+  }
+  const double* x = &m[0];
+  const double* y = &m[4];
+  const double* z = &m[8];
+  auto dot = [](const double* a, const double* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  };
+  const std::array<double, 3> y_cross_z{
+      {y[1] * z[2] - y[2] * z[1], y[2] * z[0] - y[0] * z[2], y[0] * z[1] - y[1] * z[0]}};
+  return isNear(dot(x, x), 1.0, tolerance) && isNear(dot(y, y), 1.0, tolerance) &&
+         isNear(dot(z, z), 1.0, tolerance) && isNear(dot(x, y), 0.0, tolerance) &&
+         isNear(dot(x, z), 0.0, tolerance) && isNear(dot(y, z), 0.0, tolerance) &&
+         isNear(dot(x, y_cross_z.data()), 1.0, tolerance);
+}
+
+}  // namespace detail
+
+/**
+ * Validates a received RobotState before it is trusted.
+ *
+ * Checks that every double is finite, and that O_T_EE, O_T_EE_d and F_T_EE are homogeneous
+ * transforms. The finiteness check runs vectorized over the whole state; fields are only looked
+ * at one by one if it fails.
+ *
+ * @param[in] data Start of a RobotState in a buffer of any alignment.
+ * @param[in] tolerance Tolerance for the transform checks.
+ *
+ * @return Mask of the failing fields, see getRobotStateFieldMask(). Zero if the state is valid.
+ */
+inline uint64_t validateRobotState(const uint8_t* data,
+                                   double tolerance = kTransformTolerance) noexcept {
+  uint64_t mask = 0;
+  if (!detail::areFinite(data + detail::kStateDoublesBegin, detail::kStateDoubleCount) ||
+      !std::isfinite(
+          loadUnaligned<double>(data + offsetof(RobotState, control_command_success_rate)))) {
+    mask = detail::findNonFiniteFields(data);
+  }
+  constexpr size_t kTransforms[] = {offsetof(RobotState, O_T_EE), offsetof(RobotState, O_T_EE_d),
+                                    offsetof(RobotState, F_T_EE)};
+  for (size_t offset : kTransforms) {
+    if (!detail::isHomogeneousTransform(data + offset, tolerance)) {
+      mask |= getRobotStateFieldMask(offset);
+    }
+  }
+  return mask;
+}
+
+inline uint64_t validateRobotState(const RobotState& state,
+                                   double tolerance = kTransformTolerance) noexcept {
+  return validateRobotState(reinterpret_cast<const uint8_t*>(&state), tolerance);
+}
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,183 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <research_interface/codec.h>
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace robot {
+
+/**
+ * Read-only view of a RobotState in a raw receive buffer.
+ *
+ * Each accessor loads a single field directly from the wire bytes, so only the fields that are
+ * actually used get copied. The buffer may have any alignment and has to hold at least kSize
+ * bytes for as long as the view is used.
+ */
+class RobotStateView {
+ public:
+  static constexpr size_t kSize = sizeof(RobotState);
+
+  explicit RobotStateView(const uint8_t* data) noexcept : data_(data) {}
+
+  const uint8_t* data() const noexcept { return data_; }
+
+  RobotState toRobotState() const noexcept { return load<RobotState>(0); }
+
+  uint64_t message_id() const noexcept {
+    return load<uint64_t>(offsetof(RobotState, message_id));
+  }
+  std::array<double, 16> O_T_EE() const noexcept {
+    return load<std::array<double, 16>>(offsetof(RobotState, O_T_EE));
+  }
+  std::array<double, 16> O_T_EE_d() const noexcept {
+    return load<std::array<double, 16>>(offsetof(RobotState, O_T_EE_d));
+  }
+  std::array<double, 16> F_T_EE() const noexcept {
+    return load<std::array<double, 16>>(offsetof(RobotState, F_T_EE));
+  }
+  std::array<double, 16> EE_T_K() const noexcept {
+    return load<std::array<double, 16>>(offsetof(RobotState, EE_T_K));
+  }
+  std::array<double, 16> F_T_NE() const noexcept {
+    return load<std::array<double, 16>>(offsetof(RobotState, F_T_NE));
+  }
+  std::array<double, 16> NE_T_EE() const noexcept {
+    return load<std::array<double, 16>>(offsetof(RobotState, NE_T_EE));
+  }
+  double m_ee() const noexcept {
+    return load<double>(offsetof(RobotState, m_ee));
+  }
+  std::array<double, 9> I_ee() const noexcept {
+    return load<std::array<double, 9>>(offsetof(RobotState, I_ee));
+  }
+  std::array<double, 3> F_x_Cee() const noexcept {
+    return load<std::array<double, 3>>(offsetof(RobotState, F_x_Cee));
+  }
+  double m_load() const noexcept {
+    return load<double>(offsetof(RobotState, m_load));
+  }
+  std::array<double, 9> I_load() const noexcept {
+    return load<std::array<double, 9>>(offsetof(RobotState, I_load));
+  }
+  std::array<double, 3> F_x_Cload() const noexcept {
+    return load<std::array<double, 3>>(offsetof(RobotState, F_x_Cload));
+  }
+  std::array<double, 2> elbow() const noexcept {
+    return load<std::array<double, 2>>(offsetof(RobotState, elbow));
+  }
+  std::array<double, 2> elbow_d() const noexcept {
+    return load<std::array<double, 2>>(offsetof(RobotState, elbow_d));
+  }
+  std::array<double, 7> tau_J() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, tau_J));
+  }
+  std::array<double, 7> tau_J_d() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, tau_J_d));
+  }
+  std::array<double, 7> dtau_J() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, dtau_J));
+  }
+  std::array<double, 7> q() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, q));
+  }
+  std::array<double, 7> q_d() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, q_d));
+  }
+  std::array<double, 7> dq() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, dq));
+  }
+  std::array<double, 7> dq_d() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, dq_d));
+  }
+  std::array<double, 7> ddq_d() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, ddq_d));
+  }
+  std::array<double, 7> joint_contact() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, joint_contact));
+  }
+  std::array<double, 6> cartesian_contact() const noexcept {
+    return load<std::array<double, 6>>(offsetof(RobotState, cartesian_contact));
+  }
+  std::array<double, 7> joint_collision() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, joint_collision));
+  }
+  std::array<double, 6> cartesian_collision() const noexcept {
+    return load<std::array<double, 6>>(offsetof(RobotState, cartesian_collision));
+  }
+  std::array<double, 7> tau_ext_hat_filtered() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, tau_ext_hat_filtered));
+  }
+  std::array<double, 6> O_F_ext_hat_K() const noexcept {
+    return load<std::array<double, 6>>(offsetof(RobotState, O_F_ext_hat_K));
+  }
+  std::array<double, 6> K_F_ext_hat_K() const noexcept {
+    return load<std::array<double, 6>>(offsetof(RobotState, K_F_ext_hat_K));
+  }
+  std::array<double, 6> O_dP_EE_d() const noexcept {
+    return load<std::array<double, 6>>(offsetof(RobotState, O_dP_EE_d));
+  }
+  std::array<double, 3> O_ddP_O() const noexcept {
+    return load<std::array<double, 3>>(offsetof(RobotState, O_ddP_O));
+  }
+  std::array<double, 2> elbow_c() const noexcept {
+    return load<std::array<double, 2>>(offsetof(RobotState, elbow_c));
+  }
+  std::array<double, 2> delbow_c() const noexcept {
+    return load<std::array<double, 2>>(offsetof(RobotState, delbow_c));
+  }
+  std::array<double, 2> ddelbow_c() const noexcept {
+    return load<std::array<double, 2>>(offsetof(RobotState, ddelbow_c));
+  }
+  std::array<double, 16> O_T_EE_c() const noexcept {
+    return load<std::array<double, 16>>(offsetof(RobotState, O_T_EE_c));
+  }
+  std::array<double, 6> O_dP_EE_c() const noexcept {
+    return load<std::array<double, 6>>(offsetof(RobotState, O_dP_EE_c));
+  }
+  std::array<double, 6> O_ddP_EE_c() const noexcept {
+    return load<std::array<double, 6>>(offsetof(RobotState, O_ddP_EE_c));
+  }
+  std::array<double, 7> theta() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, theta));
+  }
+  std::array<double, 7> dtheta() const noexcept {
+    return load<std::array<double, 7>>(offsetof(RobotState, dtheta));
+  }
+  MotionGeneratorMode motion_generator_mode() const noexcept {
+    return load<MotionGeneratorMode>(offsetof(RobotState, motion_generator_mode));
+  }
+  ControllerMode controller_mode() const noexcept {
+    return load<ControllerMode>(offsetof(RobotState, controller_mode));
+  }
+  std::array<bool, 41> errors() const noexcept {
+    return load<std::array<bool, 41>>(offsetof(RobotState, errors));
+  }
+  std::array<bool, 41> reflex_reason() const noexcept {
+    return load<std::array<bool, 41>>(offsetof(RobotState, reflex_reason));
+  }
+  RobotMode robot_mode() const noexcept {
+    return load<RobotMode>(offsetof(RobotState, robot_mode));
+  }
+  double control_command_success_rate() const noexcept {
+    return load<double>(offsetof(RobotState, control_command_success_rate));
+  }
+
+ private:
+  template <typename T>
+  T load(size_t offset) const noexcept {
+    return loadUnaligned<T>(data_ + offset);
+  }
+
+  const uint8_t* data_;
+};
+
+static_assert(std::is_standard_layout<RobotState>::value, "RobotState must be standard layout.");
+
+}  // namespace robot
+}  // namespace research_interface
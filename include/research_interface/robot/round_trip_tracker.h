@@ -0,0 +1,101 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <research_interface/latency_histogram.h>
+
+namespace research_interface {
+namespace robot {
+
+/**
+ * Measures the time from receiving a RobotState to sending the RobotCommand that answers it.
+ *
+ * States and commands are matched by message_id. Latencies are recorded in nanoseconds into a
+ * LatencyHistogram. Cycles whose command took longer than the budget, or that were never
+ * answered, are counted as missed. All storage is fixed, so the tracker never allocates and can
+ * stay enabled in production. Not thread-safe; call it from the control loop thread.
+ */
+class RoundTripTracker {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Number of outstanding states that can be matched with a command.
+  static constexpr size_t kPendingStates = 64;
+
+  explicit RoundTripTracker(std::chrono::nanoseconds budget = std::chrono::milliseconds(1))
+      : budget_(static_cast<uint64_t>(budget.count())) {
+    reset();
+  }
+
+  void onStateReceived(uint64_t message_id, Clock::time_point time = Clock::now()) noexcept {
+    Pending& pending = pending_[message_id % kPendingStates];
+    if (pending.valid) {
+      unanswered_++;
+    }
+    pending = {message_id, time, true};
+  }
+
+  void onCommandSent(uint64_t message_id, Clock::time_point time = Clock::now()) noexcept {
+    Pending& pending = pending_[message_id % kPendingStates];
+    if (!pending.valid || pending.message_id != message_id) {
+      unmatched_++;
+      return;
+    }
+    pending.valid = false;
+    const uint64_t latency = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time - pending.time).count());
+    histogram_.record(latency);
+    if (latency > budget_) {
+      late_++;
+    }
+  }
+
+  void reset() noexcept {
+    for (Pending& pending : pending_) {
+      pending.valid = false;
+    }
+    histogram_.reset();
+    late_ = 0;
+    unanswered_ = 0;
+    unmatched_ = 0;
+  }
+
+  /// Round-trip latencies in nanoseconds.
+  const LatencyHistogram& histogram() const noexcept { return histogram_; }
+
+  uint64_t p50() const noexcept { return histogram_.getPercentile(50.0); }
+  uint64_t p99() const noexcept { return histogram_.getPercentile(99.0); }
+  uint64_t p999() const noexcept { return histogram_.getPercentile(99.9); }
+  uint64_t max() const noexcept { return histogram_.max(); }
+
+  /// Commands sent after the budget elapsed.
+  uint64_t late() const noexcept { return late_; }
+  /// States that were not answered before their slot was reused.
+  uint64_t unanswered() const noexcept { return unanswered_; }
+  /// Commands without a matching state.
+  uint64_t unmatched() const noexcept { return unmatched_; }
+  /// Cycles that missed the budget, either late or not answered at all.
+  uint64_t missed() const noexcept { return late_ + unanswered_; }
+
+ private:
+  struct Pending {
+    uint64_t message_id;
+    Clock::time_point time;
+    bool valid;
+  };
+
+  const uint64_t budget_;
+  std::array<Pending, kPendingStates> pending_;
+  LatencyHistogram histogram_;
+  uint64_t late_;
+  uint64_t unanswered_;
+  uint64_t unmatched_;
+};
+
+}  // namespace robot
+}  // namespace research_interface
@@ -2,7 +2,9 @@
 // Use of this source code is governed by the Apache-2.0 license, see LICENSE
 #pragma once
 
+#include <research_interface/command_registry.h>
 #include <research_interface/robot/service_types.h>
+#include <research_interface/type_list.h>
 
 namespace research_interface {
 namespace robot {
@@ -10,6 +12,11 @@ namespace robot {
 template <typename T>
 struct CommandTraits {};
 
+template <>
+struct CommandTraits<Connect> {
+  static constexpr const char* kName = "Connect";
+};
+
 template <>
 struct CommandTraits<Move> {
   static constexpr const char* kName = "Move";
@@ -70,5 +77,34 @@ struct CommandTraits<AutomaticErrorRecovery> {
   static constexpr const char* kName = "Automatic Error Recovery";
 };
 
+template <>
+struct CommandTraits<LoadModelLibrary> {
+  static constexpr const char* kName = "Load Model Library";
+};
+
+/// All commands, in the order of Command.
+using Commands = TypeList<Connect,
+                          Move,
+                          StopMove,
+                          GetCartesianLimit,
+                          SetCollisionBehavior,
+                          SetJointImpedance,
+                          SetCartesianImpedance,
+                          SetGuidingMode,
+                          SetEEToK,
+                          SetNEToEE,
+                          SetLoad,
+                          SetFilters,
+                          AutomaticErrorRecovery,
+                          LoadModelLibrary>;
+
+using Registry = CommandRegistry<Commands, CommandTraits>;
+
+/// Size of the largest request or response message on the wire.
+constexpr size_t kMaxMessageSize = Registry::kMaxMessageSize;
+
+static_assert(Registry::kCount == static_cast<size_t>(Command::kLoadModelLibrary) + 1,
+              "Registry must contain all commands.");
+
 }  // namespace robot
 }  // namespace research_interface
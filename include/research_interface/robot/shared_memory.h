@@ -0,0 +1,386 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <research_interface/broadcast_ring.h>
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/service_types.h>
+#include <research_interface/seqlock.h>
+
+namespace research_interface {
+namespace robot {
+
+constexpr uint32_t kSharedMemoryMagic = 0x46524b41;  // "FRKA"
+constexpr uint32_t kSharedMemoryLayoutVersion = 2;
+constexpr size_t kSharedStateCapacity = 1024;
+constexpr size_t kSharedCommandCapacity = 1024;
+
+/// Number of torn reads after which SharedMemoryReader::latestState() gives up.
+constexpr size_t kSharedMemoryReadAttempts = 64;
+
+/// Time a new writer has to lock a segment it created before the segment counts as abandoned.
+constexpr std::chrono::milliseconds kSharedMemoryInitializationGrace(100);
+
+struct SharedMemoryHeader {
+  /// Set to kSharedMemoryMagic once the segment is fully initialized.
+  std::atomic<uint32_t> magic;
+  uint32_t layout_version;
+  Version version;
+  uint64_t size;
+  /// Process that created the segment, used to detect segments left behind by a crash.
+  int64_t writer_pid;
+};
+
+/**
+ * Layout of a shared-memory segment carrying the RobotState and RobotCommand streams of one
+ * robot. Both streams are written by the process that owns the segment, i.e. the one that talks
+ * to the robot; the command stream mirrors the commands it sent. Any number of readers map the
+ * segment read-only.
+ */
+struct SharedMemoryLayout {
+  SharedMemoryHeader header;
+  Seqlock<RobotState> latest_state;
+  BroadcastRing<RobotState, kSharedStateCapacity> states;
+  BroadcastRing<RobotCommand, kSharedCommandCapacity> commands;
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+              "Shared memory requires lock-free atomics.");
+
+namespace detail {
+
+/**
+ * Maps a segment. A creating mapping holds an exclusive flock() on the segment from its creation
+ * until finishInitialization(), so that other writers do not mistake it for an abandoned one.
+ */
+class SharedMemoryMapping {
+ public:
+  SharedMemoryMapping(const std::string& name, bool create) : name_(name), owner_(create) {
+    int fd = create ? createLocked(name) : ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (create && fd == -1 && errno == EEXIST) {
+      if (removeIfStale(name)) {
+        fd = createLocked(name);
+      } else {
+        errno = EEXIST;
+      }
+    }
+    if (fd == -1) {
+      throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+    }
+    if (create && ::ftruncate(fd, sizeof(SharedMemoryLayout)) == -1) {
+      const int error = errno;
+      ::shm_unlink(name.c_str());
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "ftruncate " + name);
+    }
+    struct stat status;
+    if (!create && (::fstat(fd, &status) == -1 ||
+                    static_cast<size_t>(status.st_size) < sizeof(SharedMemoryLayout))) {
+      ::close(fd);
+      throw std::runtime_error("Shared memory segment " + name + " is not initialized.");
+    }
+    void* address = ::mmap(nullptr, sizeof(SharedMemoryLayout),
+                           create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    const int error = errno;
+    if (address == MAP_FAILED) {
+      if (create) {
+        ::shm_unlink(name.c_str());
+      }
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "mmap " + name);
+    }
+    address_ = address;
+    if (create) {
+      lock_fd_ = fd;
+    } else {
+      ::close(fd);
+    }
+  }
+
+  ~SharedMemoryMapping() {
+    ::munmap(address_, sizeof(SharedMemoryLayout));
+    if (owner_) {
+      ::shm_unlink(name_.c_str());
+    }
+    finishInitialization();
+  }
+
+  SharedMemoryMapping(const SharedMemoryMapping&) = delete;
+  SharedMemoryMapping& operator=(const SharedMemoryMapping&) = delete;
+
+  void* address() const noexcept { return address_; }
+
+  /**
+   * Releases the initialization lock; call once the header magic is set.
+   */
+  void finishInitialization() noexcept {
+    if (lock_fd_ != -1) {
+      ::close(lock_fd_);
+      lock_fd_ = -1;
+    }
+  }
+
+ private:
+  enum class SegmentState { kLive, kInitializing, kStale };
+
+  static int createLocked(const std::string& name) noexcept {
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd != -1) {
+      // Blocks only while another writer inspects the new segment in removeIfStale().
+      ::flock(fd, LOCK_EX);
+    }
+    return fd;
+  }
+
+  /**
+   * Removes an existing segment if it was left behind by a writer that no longer runs.
+   *
+   * A segment without magic may belong to a writer that has created but not yet locked it, so it
+   * is only removed if it is still unlocked and uninitialized after
+   * kSharedMemoryInitializationGrace.
+   *
+   * @return True if the segment was removed or no longer exists.
+   */
+  static bool removeIfStale(const std::string& name) noexcept {
+    for (int attempt = 0; attempt < 2; attempt++) {
+      if (attempt > 0) {
+        std::this_thread::sleep_for(kSharedMemoryInitializationGrace);
+      }
+      const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+      if (fd == -1) {
+        return errno == ENOENT;
+      }
+      // Locked segments are being initialized by their writer or inspected by another one.
+      SegmentState state = SegmentState::kLive;
+      if (::flock(fd, LOCK_EX | LOCK_NB) == 0) {
+        state = inspect(fd);
+        if (state == SegmentState::kInitializing && attempt > 0) {
+          state = SegmentState::kStale;
+        }
+        // Only unlink the segment that was inspected, not one another writer has put in its place.
+        if (state == SegmentState::kStale) {
+          if (refersTo(name, fd)) {
+            ::shm_unlink(name.c_str());
+          } else {
+            state = SegmentState::kLive;
+          }
+        }
+      }
+      ::close(fd);
+      if (state != SegmentState::kInitializing) {
+        return state == SegmentState::kStale;
+      }
+    }
+    return false;
+  }
+
+  static SegmentState inspect(int fd) noexcept {
+    struct stat status;
+    if (::fstat(fd, &status) == -1) {
+      return SegmentState::kLive;
+    }
+    if (static_cast<size_t>(status.st_size) < sizeof(SharedMemoryHeader)) {
+      return SegmentState::kInitializing;
+    }
+    void* address = ::mmap(nullptr, sizeof(SharedMemoryHeader), PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      return SegmentState::kLive;
+    }
+    const SharedMemoryHeader* header = static_cast<const SharedMemoryHeader*>(address);
+    SegmentState state = SegmentState::kLive;
+    if (header->magic.load(std::memory_order_acquire) != kSharedMemoryMagic) {
+      state = SegmentState::kInitializing;
+    } else if (header->layout_version == kSharedMemoryLayoutVersion &&
+               ::kill(static_cast<pid_t>(header->writer_pid), 0) == -1 && errno == ESRCH) {
+      state = SegmentState::kStale;
+    }
+    ::munmap(address, sizeof(SharedMemoryHeader));
+    return state;
+  }
+
+  static bool refersTo(const std::string& name, int fd) noexcept {
+    const int current = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (current == -1) {
+      return false;
+    }
+    struct stat expected;
+    struct stat actual;
+    const bool same = ::fstat(fd, &expected) == 0 && ::fstat(current, &actual) == 0 &&
+                      expected.st_dev == actual.st_dev && expected.st_ino == actual.st_ino;
+    ::close(current);
+    return same;
+  }
+
+  std::string name_;
+  bool owner_;
+  void* address_ = nullptr;
+  int lock_fd_ = -1;
+};
+
+}  // namespace detail
+
+/**
+ * Creates a shared-memory segment and publishes robot states and commands into it.
+ *
+ * The segment is removed again on destruction. If a segment with the same name was left behind
+ * by a writer process that crashed, it is replaced. A crashed writer is detected by the process
+ * ID recorded in the segment; if that ID has since been reused by another process, the segment
+ * looks alive and has to be removed manually, e.g. from /dev/shm. Publishing does not perform
+ * any system calls.
+ */
+class SharedMemoryWriter {
+ public:
+  /**
+   * @param[in] name POSIX shared-memory object name, e.g. "/franka_robot".
+   *
+   * @throw std::system_error if the segment cannot be created, e.g. because another running
+   * writer owns it.
+   */
+  explicit SharedMemoryWriter(const std::string& name)
+      : mapping_(name, true), layout_(new (mapping_.address()) SharedMemoryLayout) {
+    layout_->header.layout_version = kSharedMemoryLayoutVersion;
+    layout_->header.version = kVersion;
+    layout_->header.size = sizeof(SharedMemoryLayout);
+    layout_->header.writer_pid = ::getpid();
+    layout_->header.magic.store(kSharedMemoryMagic, std::memory_order_release);
+    mapping_.finishInitialization();
+  }
+
+  ~SharedMemoryWriter() { layout_->~SharedMemoryLayout(); }
+
+  /**
+   * Publishes a state as the latest one and appends it to the state ring.
+   * Must only be called from a single thread.
+   */
+  void publish(const RobotState& state) noexcept {
+    layout_->latest_state.store(state);
+    layout_->states.push(state);
+  }
+
+  /**
+   * Appends a command to the command ring, typically each command sent to the robot. Must only be
+   * called from a single thread.
+   */
+  void publish(const RobotCommand& command) noexcept { layout_->commands.push(command); }
+
+ private:
+  detail::SharedMemoryMapping mapping_;
+  SharedMemoryLayout* layout_;
+};
+
+/**
+ * Reads robot states and commands from a segment created by a SharedMemoryWriter.
+ *
+ * Every reader follows the streams independently, starting with the elements published after
+ * it was constructed. Readers map the segment read-only and cannot publish commands themselves;
+ * processes that want to command the robot have to send their commands to the segment owner.
+ * Reading does not perform any system calls, and never blocks, even if the writer crashed in the
+ * middle of publishing.
+ */
+class SharedMemoryReader {
+ public:
+  /**
+   * @param[in] name POSIX shared-memory object name passed to the SharedMemoryWriter.
+   *
+   * @throw std::system_error if the segment cannot be opened.
+   * @throw std::runtime_error if the segment has not been initialized or is incompatible.
+   */
+  explicit SharedMemoryReader(const std::string& name)
+      : mapping_(name, false),
+        layout_(static_cast<const SharedMemoryLayout*>(mapping_.address())) {
+    if (layout_->header.magic.load(std::memory_order_acquire) != kSharedMemoryMagic) {
+      throw std::runtime_error("Shared memory segment " + name + " is not initialized.");
+    }
+    if (layout_->header.layout_version != kSharedMemoryLayoutVersion ||
+        layout_->header.version != kVersion ||
+        layout_->header.size != sizeof(SharedMemoryLayout)) {
+      throw std::runtime_error("Shared memory segment " + name + " has an incompatible layout.");
+    }
+    next_state_ = layout_->states.end();
+    next_command_ = layout_->commands.end();
+  }
+
+  /**
+   * Reads the most recently published state.
+   *
+   * @param[out] state Set to the state on success.
+   *
+   * @return False if no consistent copy could be made within kSharedMemoryReadAttempts attempts,
+   * e.g. because the writer stopped in the middle of publishing.
+   */
+  bool latestState(RobotState& state) const noexcept {
+    return layout_->latest_state.load(state, kSharedMemoryReadAttempts);
+  }
+
+  /**
+   * Reads the next state from the state ring. States that were overwritten before they could
+   * be read are skipped and counted in lostStates().
+   *
+   * @return False if there is no new state.
+   */
+  bool nextState(RobotState& state) noexcept {
+    return next(layout_->states, next_state_, lost_states_, state);
+  }
+
+  /**
+   * Reads the next command from the command ring. Commands that were overwritten before they
+   * could be read are skipped and counted in lostCommands().
+   *
+   * @return False if there is no new command.
+   */
+  bool nextCommand(RobotCommand& command) noexcept {
+    return next(layout_->commands, next_command_, lost_commands_, command);
+  }
+
+  uint64_t lostStates() const noexcept { return lost_states_; }
+  uint64_t lostCommands() const noexcept { return lost_commands_; }
+
+ private:
+  template <typename Ring, typename T>
+  static bool next(const Ring& ring, uint64_t& index, uint64_t& lost, T& value) noexcept {
+    while (true) {
+      switch (ring.read(index, value)) {
+        case Ring::ReadResult::kSuccess:
+          index++;
+          return true;
+        case Ring::ReadResult::kEmpty:
+          return false;
+        case Ring::ReadResult::kOverrun: {
+          const uint64_t oldest = ring.end() - Ring::kCapacity + 1;
+          lost += oldest - index;
+          index = oldest;
+          break;
+        }
+      }
+    }
+  }
+
+  detail::SharedMemoryMapping mapping_;
+  const SharedMemoryLayout* layout_;
+  uint64_t next_state_;
+  uint64_t next_command_;
+  uint64_t lost_states_ = 0;
+  uint64_t lost_commands_ = 0;
+};
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,155 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <research_interface/robot/rbk_types.h>
+
+namespace research_interface {
+namespace robot {
+
+/**
+ * Streaming analysis of the incoming RobotState::message_id sequence.
+ *
+ * Counts lost, duplicated and reordered states, and computes a host-side success rate over the
+ * last Window message IDs. It also tracks an RFC 3550 style inter-arrival jitter. The robot
+ * reports control_command_success_rate from its side. Comparing the two tells losses of states
+ * (low host rate) apart from losses of commands or late commands (high host rate, low reported
+ * rate). Each packet is processed in amortized O(1) and nothing is allocated.
+ *
+ * @tparam Window Number of message IDs for the host-side success rate, a multiple of 64.
+ */
+template <size_t Window = 128>
+class StateStreamAnalyzer {
+ public:
+  static_assert(Window > 0 && Window % 64 == 0, "Window must be a multiple of 64.");
+
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @param[in] period Nominal interval between two consecutive message IDs.
+   */
+  explicit StateStreamAnalyzer(std::chrono::nanoseconds period = std::chrono::milliseconds(1))
+      : period_(static_cast<double>(period.count())) {}
+
+  void onStateReceived(const RobotState& state, Clock::time_point time = Clock::now()) noexcept {
+    onStateReceived(state.message_id, state.control_command_success_rate, time);
+  }
+
+  void onStateReceived(uint64_t message_id,
+                       double reported_success_rate,
+                       Clock::time_point time = Clock::now()) noexcept {
+    if (received_ == 0) {
+      start(message_id, time);
+    } else if (message_id > newest_) {
+      advance(message_id, time);
+    } else if (newest_ - message_id < Window && message_id >= first_) {
+      if (test(message_id)) {
+        duplicates_++;
+        return;
+      }
+      set(message_id);
+      window_received_++;
+      lost_--;
+      reordered_++;
+    } else {
+      // Too old to tell apart from a duplicate.
+      reordered_++;
+      return;
+    }
+    received_++;
+    reported_success_rate_ = reported_success_rate;
+  }
+
+  uint64_t received() const noexcept { return received_; }
+  /// States missing from the sequence so far; decreases again if they arrive late.
+  uint64_t lost() const noexcept { return lost_; }
+  uint64_t duplicates() const noexcept { return duplicates_; }
+  uint64_t reordered() const noexcept { return reordered_; }
+
+  /// Fraction of the last Window message IDs that were received.
+  double hostSuccessRate() const noexcept {
+    const uint64_t expected = std::min<uint64_t>(newest_ - first_ + 1, Window);
+    return received_ > 0 ? static_cast<double>(window_received_) / expected : 0.0;
+  }
+
+  /// control_command_success_rate of the newest state.
+  double reportedSuccessRate() const noexcept { return reported_success_rate_; }
+
+  /// Smoothed inter-arrival jitter.
+  std::chrono::nanoseconds jitter() const noexcept {
+    return std::chrono::nanoseconds(static_cast<int64_t>(jitter_));
+  }
+
+ private:
+  void start(uint64_t message_id, Clock::time_point time) noexcept {
+    first_ = message_id;
+    newest_ = message_id;
+    newest_time_ = time;
+    set(message_id);
+    window_received_ = 1;
+  }
+
+  void advance(uint64_t message_id, Clock::time_point time) noexcept {
+    const uint64_t step = message_id - newest_;
+    if (step >= Window) {
+      bits_.fill(0);
+      window_received_ = 0;
+    } else {
+      for (uint64_t id = newest_ + 1; id <= message_id; id++) {
+        if (test(id)) {
+          window_received_--;
+        }
+        clear(id);
+      }
+    }
+    set(message_id);
+    window_received_++;
+    lost_ += step - 1;
+
+    const double transit = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time - newest_time_).count());
+    const double deviation = std::abs(transit - period_ * static_cast<double>(step));
+    jitter_ += (deviation - jitter_) / 16.0;
+
+    newest_ = message_id;
+    newest_time_ = time;
+  }
+
+  bool test(uint64_t message_id) const noexcept {
+    const size_t bit = message_id % Window;
+    return ((bits_[bit / 64] >> (bit % 64)) & 1) != 0;
+  }
+
+  void set(uint64_t message_id) noexcept {
+    const size_t bit = message_id % Window;
+    bits_[bit / 64] |= uint64_t{1} << (bit % 64);
+  }
+
+  void clear(uint64_t message_id) noexcept {
+    const size_t bit = message_id % Window;
+    bits_[bit / 64] &= ~(uint64_t{1} << (bit % 64));
+  }
+
+  const double period_;
+  std::array<uint64_t, Window / 64> bits_{};
+  uint64_t first_ = 0;
+  uint64_t newest_ = 0;
+  Clock::time_point newest_time_;
+  uint64_t window_received_ = 0;
+  uint64_t received_ = 0;
+  uint64_t lost_ = 0;
+  uint64_t duplicates_ = 0;
+  uint64_t reordered_ = 0;
+  double reported_success_rate_ = 0.0;
+  double jitter_ = 0.0;
+};
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,127 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <research_interface/robot/error_set.h>
+#include <research_interface/robot/joint_batch.h>
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/robot_state_aligned.h>
+
+namespace research_interface {
+namespace robot {
+
+/**
+ * Torque limits from the Panda datasheet. Stricter limits can be passed to TorqueRateLimiter as
+ * another type with static maxTorque() and maxTorqueRate().
+ */
+struct PandaTorqueLimits {
+  /// Maximum absolute torque in Nm.
+  static constexpr std::array<double, 7> maxTorque() noexcept {
+    return {{87.0, 87.0, 87.0, 87.0, 12.0, 12.0, 12.0}};
+  }
+
+  /// Maximum absolute torque rate in Nm/s.
+  static constexpr std::array<double, 7> maxTorqueRate() noexcept {
+    return {{1000.0, 1000.0, 1000.0, 1000.0, 1000.0, 1000.0, 1000.0}};
+  }
+};
+
+/**
+ * Rate limiter and saturator for ControllerCommand::tau_J_d.
+ *
+ * Clamps each commanded torque to within one period's maximum torque rate of the previously
+ * sent torque, and then to the maximum torque, so that commands trigger neither
+ * kControllerTorqueDiscontinuity nor kTauJRangeViolation. NaNs are replaced by the previously
+ * sent torque, so the joint holds its torque. Counts how often clamping was necessary, per
+ * command and per joint, to help tuning controllers. Never allocates.
+ *
+ * @tparam Limits Limit set, see PandaTorqueLimits.
+ */
+template <typename Limits = PandaTorqueLimits>
+class TorqueRateLimiter {
+ public:
+  /**
+   * @param[in] period Control period, i.e. the time between two commands.
+   */
+  explicit TorqueRateLimiter(std::chrono::nanoseconds period = std::chrono::milliseconds(1))
+      : previous_{} {
+    constexpr std::array<double, 7> kMaxTorque = Limits::maxTorque();
+    constexpr std::array<double, 7> kMaxTorqueRate = Limits::maxTorqueRate();
+    const double seconds = std::chrono::duration<double>(period).count();
+    for (size_t i = 0; i < kJointCount; i++) {
+      max_torque_[i] = kMaxTorque[i];
+      max_step_[i] = kMaxTorqueRate[i] * seconds;
+    }
+    max_torque_[kJointCount] = 0.0;
+    max_step_[kJointCount] = 0.0;
+  }
+
+  /**
+   * Starts from the torques last commanded to the robot, e.g. at the beginning of a motion.
+   */
+  void reset(const RobotState& state) noexcept {
+    simd::store(
+        simd::loadJoints(reinterpret_cast<const uint8_t*>(&state) + offsetof(RobotState, tau_J_d)),
+        previous_);
+  }
+
+  /**
+   * Limits command.tau_J_d in place and remembers the result as the previously sent torque.
+   *
+   * @return Mask of the clamped joints; bit i is set if joint i was changed.
+   */
+  uint32_t limit(ControllerCommand& command) noexcept {
+    uint8_t* tau_J_d = reinterpret_cast<uint8_t*>(&command) + offsetof(ControllerCommand, tau_J_d);
+    const simd::JointBatch requested = simd::loadJoints(tau_J_d);
+    const simd::JointBatch previous = simd::load(previous_);
+    const simd::JointBatch max_step = simd::load(max_step_);
+    const simd::JointBatch max_torque = simd::load(max_torque_);
+    // clamp() would map NaN to the lower bound, so NaN lanes hold the previous torque instead.
+    const simd::JointBatch rate_limited = simd::clamp(simd::replaceNaN(requested, previous),
+                                                      previous - max_step, previous + max_step);
+    const simd::JointBatch limited =
+        simd::clamp(rate_limited, simd::broadcast(0.0) - max_torque, max_torque);
+    simd::storeJoints(limited, tau_J_d);
+    simd::store(limited, previous_);
+
+    // NaN differences count as clamped, too.
+    const uint32_t clamped =
+        simd::greaterMask(simd::abs(requested - limited), simd::broadcast(0.0));
+    if (clamped != 0) {
+      clamped_commands_++;
+      for (uint32_t bits = clamped; bits != 0; bits &= bits - 1) {
+        clamped_joints_[detail::countTrailingZeros(bits)]++;
+      }
+    }
+    return clamped;
+  }
+
+  /// Torques that were last sent.
+  const AlignedJointVector& previous() const noexcept { return previous_; }
+
+  /// Number of commands in which at least one joint was clamped.
+  uint64_t clampedCommands() const noexcept { return clamped_commands_; }
+
+  /// Number of commands in which the given joint was clamped.
+  uint64_t clampedJoints(size_t joint) const noexcept { return clamped_joints_[joint]; }
+
+  void resetCounters() noexcept {
+    clamped_commands_ = 0;
+    clamped_joints_.fill(0);
+  }
+
+ private:
+  AlignedJointVector max_torque_;
+  AlignedJointVector max_step_;
+  AlignedJointVector previous_;
+  uint64_t clamped_commands_ = 0;
+  std::array<uint64_t, kJointCount> clamped_joints_{};
+};
+
+}  // namespace robot
+}  // namespace research_interface
@@ -0,0 +1,115 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <research_interface/spsc_queue.h>
+
+namespace research_interface {
+
+/**
+ * Single-writer/many-reader cell holding the latest value of T, e.g. a robot::RobotState,
+ * gripper::GripperState or vacuum_gripper::VacuumGripperState.
+ *
+ * The writer never blocks. Readers retry if the value changed while they were copying it. The
+ * value is stored in atomic words, so concurrent reads and writes are free of data races.
+ *
+ * @tparam T Trivially copyable value type.
+ */
+template <typename T>
+class Seqlock {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+
+  Seqlock() = default;
+  Seqlock(const Seqlock&) = delete;
+  Seqlock& operator=(const Seqlock&) = delete;
+
+  /**
+   * Publishes a new value. Must only be called from a single writer thread.
+   */
+  void store(const T& value) noexcept {
+    std::array<uint64_t, kWordCount> words{};
+    std::memcpy(words.data(), &value, sizeof(value));
+
+    const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWordCount; i++) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /**
+   * Tries to read the latest value once.
+   *
+   * @param[out] value Set to the latest value on success.
+   *
+   * @return False if a concurrent store() tore the read.
+   */
+  bool tryLoad(T& value) const noexcept {
+    const uint64_t before = sequence_.load(std::memory_order_acquire);
+    if ((before & 1) != 0) {
+      return false;
+    }
+    std::array<uint64_t, kWordCount> words;
+    for (size_t i = 0; i < kWordCount; i++) {
+      words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    std::memcpy(&value, words.data(), sizeof(value));
+    return true;
+  }
+
+  /**
+   * Reads the latest value, retrying until a consistent copy was made. Spins forever if the
+   * writer stopped in the middle of a store(); use the bounded overload if the writer can die,
+   * e.g. in shared memory.
+   */
+  T load() const noexcept {
+    T value;
+    while (!tryLoad(value)) {
+    }
+    return value;
+  }
+
+  /**
+   * Reads the latest value, trying at most max_attempts times.
+   *
+   * @param[out] value Set to the latest value on success.
+   * @param[in] max_attempts Maximum number of tryLoad() calls.
+   *
+   * @return False if all attempts were torn by concurrent or interrupted store() calls.
+   */
+  bool load(T& value, size_t max_attempts) const noexcept {
+    for (size_t i = 0; i < max_attempts; i++) {
+      if (tryLoad(value)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Number of completed store() calls, usable to detect new values.
+   */
+  uint64_t version() const noexcept { return sequence_.load(std::memory_order_acquire) / 2; }
+
+ private:
+  static constexpr size_t kWordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  alignas(kCacheLineSize) std::atomic<uint64_t> sequence_{0};
+  std::array<std::atomic<uint64_t>, kWordCount> words_{};
+};
+
+}  // namespace research_interface
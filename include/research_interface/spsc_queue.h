@@ -0,0 +1,93 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace research_interface {
+
+constexpr size_t kCacheLineSize = 64;
+
+/**
+ * Wait-free single-producer/single-consumer ring buffer with fixed capacity.
+ *
+ * All storage is part of the object, so nothing is allocated after construction. push() may only
+ * be called from one thread and pop() from one other thread.
+ *
+ * @tparam T Trivially copyable element type.
+ * @tparam Capacity Maximum number of queued elements, must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two.");
+
+  static constexpr size_t kCapacity = Capacity;
+
+  SpscQueue() = default;
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /**
+   * Enqueues a copy of value. Producer only.
+   *
+   * @return False if the queue is full.
+   */
+  bool push(const T& value) noexcept {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ == Capacity) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == Capacity) {
+        return false;
+      }
+    }
+    slots_[tail & (Capacity - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Dequeues the oldest element. Consumer only.
+   *
+   * @return False if the queue is empty.
+   */
+  bool pop(T& value) noexcept {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+    value = slots_[head & (Capacity - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Approximate number of queued elements; exact only if both sides are idle.
+   */
+  size_t size() const noexcept {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+ private:
+  // Producer side.
+  alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+  size_t cached_head_ = 0;
+
+  // Consumer side.
+  alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+  size_t cached_tail_ = 0;
+
+  alignas(kCacheLineSize) std::array<T, Capacity> slots_;
+};
+
+}  // namespace research_interface
@@ -0,0 +1,102 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include <research_interface/spsc_queue.h>
+
+namespace research_interface {
+
+/**
+ * Lock-free triple buffer handing the most recent value from one writer to one reader.
+ *
+ * The writer always has a free buffer to fill and the reader always gets the latest published
+ * value; neither side ever waits. Values published but replaced before the reader picked them
+ * up are counted as overwritten.
+ *
+ * @tparam T Trivially copyable value type.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+
+  TripleBuffer() = default;
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  /**
+   * Buffer to be filled by the writer before calling publish(). Writer only.
+   */
+  T& writeBuffer() noexcept { return slots_[back_].value; }
+
+  /**
+   * Makes the write buffer available to the reader. Writer only.
+   */
+  void publish() noexcept {
+    const uint8_t previous =
+        state_.exchange(static_cast<uint8_t>(back_ | kDirty), std::memory_order_acq_rel);
+    back_ = static_cast<uint8_t>(previous & kIndexMask);
+    if ((previous & kDirty) != 0) {
+      overwritten_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Copies value into the write buffer and publishes it. Writer only.
+   */
+  void publish(const T& value) noexcept {
+    writeBuffer() = value;
+    publish();
+  }
+
+  /**
+   * Switches the read buffer to the latest published value, if there is a new one. Reader only.
+   *
+   * @return True if readBuffer() now holds a value not seen before.
+   */
+  bool update() noexcept {
+    if ((state_.load(std::memory_order_relaxed) & kDirty) == 0) {
+      return false;
+    }
+    front_ = static_cast<uint8_t>(state_.exchange(front_, std::memory_order_acq_rel) & kIndexMask);
+    return true;
+  }
+
+  /**
+   * Value selected by the last successful update(). Reader only.
+   */
+  const T& readBuffer() const noexcept { return slots_[front_].value; }
+
+  /**
+   * Number of published values that were replaced before the reader picked them up.
+   */
+  uint64_t overwrittenCount() const noexcept {
+    return overwritten_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr uint8_t kIndexMask = 0x3;
+  static constexpr uint8_t kDirty = 0x4;
+
+  struct alignas(kCacheLineSize) Slot {
+    T value;
+  };
+
+  std::array<Slot, 3> slots_{};
+
+  alignas(kCacheLineSize) std::atomic<uint8_t> state_{1};
+  std::atomic<uint64_t> overwritten_{0};
+
+  // Writer side.
+  alignas(kCacheLineSize) uint8_t back_ = 0;
+
+  // Reader side.
+  alignas(kCacheLineSize) uint8_t front_ = 2;
+};
+
+}  // namespace research_interface
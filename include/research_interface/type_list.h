@@ -0,0 +1,56 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace research_interface {
+
+/**
+ * Compile-time list of types.
+ */
+template <typename... Ts>
+struct TypeList {
+  static constexpr size_t kSize = sizeof...(Ts);
+};
+
+/**
+ * Stands in for a value of T, e.g. to pass a type to a generic lambda.
+ */
+template <typename T>
+struct TypeTag {
+  using type = T;
+};
+
+/**
+ * Type at index I of List.
+ */
+template <size_t I, typename List>
+struct TypeAt;
+
+template <typename T, typename... Ts>
+struct TypeAt<0, TypeList<T, Ts...>> {
+  using type = T;
+};
+
+template <size_t I, typename T, typename... Ts>
+struct TypeAt<I, TypeList<T, Ts...>> : TypeAt<I - 1, TypeList<Ts...>> {};
+
+/**
+ * Index of the first occurrence of T in List, or List::kSize if T is not contained.
+ */
+template <typename T, typename List>
+struct IndexOf;
+
+template <typename T>
+struct IndexOf<T, TypeList<>> : std::integral_constant<size_t, 0> {};
+
+template <typename T, typename... Ts>
+struct IndexOf<T, TypeList<T, Ts...>> : std::integral_constant<size_t, 0> {};
+
+template <typename T, typename U, typename... Ts>
+struct IndexOf<T, TypeList<U, Ts...>>
+    : std::integral_constant<size_t, 1 + IndexOf<T, TypeList<Ts...>>::value> {};
+
+}  // namespace research_interface
@@ -0,0 +1,47 @@
+// Copyright (c) 2019 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <research_interface/command_registry.h>
+#include <research_interface/vacuum_gripper/types.h>
+#include <research_interface/type_list.h>
+
+namespace research_interface {
+namespace vacuum_gripper {
+
+template <typename T>
+struct CommandTraits {};
+
+template <>
+struct CommandTraits<Connect> {
+  static constexpr const char* kName = "Connect";
+};
+
+template <>
+struct CommandTraits<Vacuum> {
+  static constexpr const char* kName = "Vacuum";
+};
+
+template <>
+struct CommandTraits<DropOff> {
+  static constexpr const char* kName = "Drop Off";
+};
+
+template <>
+struct CommandTraits<Stop> {
+  static constexpr const char* kName = "Stop";
+};
+
+/// All commands, in the order of Command.
+using Commands = TypeList<Connect, Vacuum, DropOff, Stop>;
+
+using Registry = CommandRegistry<Commands, CommandTraits>;
+
+/// Size of the largest request or response message on the wire.
+constexpr size_t kMaxMessageSize = Registry::kMaxMessageSize;
+
+static_assert(Registry::kCount == static_cast<size_t>(Command::kStop) + 1,
+              "Registry must contain all commands.");
+
+}  // namespace vacuum_gripper
+}  // namespace research_interface
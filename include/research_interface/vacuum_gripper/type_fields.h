@@ -0,0 +1,28 @@
+// Copyright (c) 2019 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <research_interface/field_descriptor.h>
+#include <research_interface/vacuum_gripper/types.h>
+
+namespace research_interface {
+namespace vacuum_gripper {
+
+constexpr std::array<FieldDescriptor, 7> kVacuumGripperStateFields{{
+    RESEARCH_INTERFACE_FIELD(VacuumGripperState, message_id),
+    RESEARCH_INTERFACE_FIELD(VacuumGripperState, in_control_range),
+    RESEARCH_INTERFACE_FIELD(VacuumGripperState, part_detached),
+    RESEARCH_INTERFACE_FIELD(VacuumGripperState, part_present),
+    RESEARCH_INTERFACE_FIELD(VacuumGripperState, device_status),
+    RESEARCH_INTERFACE_FIELD(VacuumGripperState, actual_power),
+    RESEARCH_INTERFACE_FIELD(VacuumGripperState, vacuum)
+}};
+
+static_assert(coversExactly(kVacuumGripperStateFields, sizeof(VacuumGripperState)),
+              "kVacuumGripperStateFields must cover VacuumGripperState exactly.");
+
+}  // namespace vacuum_gripper
+}  // namespace research_interface
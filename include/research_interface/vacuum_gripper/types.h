@@ -8,6 +8,8 @@
 #include <cstring>
 #include <type_traits>
 
+#include <research_interface/codec.h>
+
 namespace research_interface {
 namespace vacuum_gripper {
 
@@ -61,7 +63,7 @@ struct CommandMessage {
     std::memcpy(payload.data(), &instance, payload.size());
   }
 
-  T getInstance() const noexcept { return *reinterpret_cast<const T*>(payload.data()); }
+  T getInstance() const noexcept { return bitCast<T>(payload); }
 
   CommandHeader header;
   std::array<uint8_t, sizeof(T)> payload;
@@ -0,0 +1,90 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <research_interface/codec.h>
+#include <research_interface/message_encoding.h>
+
+namespace research_interface {
+
+/**
+ * Reusable storage for a request or response T.
+ *
+ * The Request and Response types have const data members, so they can neither be
+ * default-constructed nor assigned. WireStorage<T> holds the object representation of a T
+ * instead. It has the same size and wire layout as T, but can be default-constructed, assigned
+ * and overwritten in place. This makes it usable as an element of queues, triple buffers or
+ * preallocated pools.
+ */
+template <typename T>
+class WireStorage {
+ public:
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable.");
+  static_assert(std::is_trivially_destructible<T>::value, "T must be trivially destructible.");
+  static_assert(!std::is_empty<T>::value, "Payloads without data members need no storage.");
+  static_assert(alignof(T) == 1, "T must be a packed wire type.");
+
+  WireStorage() noexcept = default;
+  explicit WireStorage(const T& instance) noexcept { set(instance); }
+
+  WireStorage& operator=(const T& instance) noexcept {
+    set(instance);
+    return *this;
+  }
+
+  /**
+   * Replaces the stored instance with a T constructed from args, directly in the storage.
+   */
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    new (data()) T(std::forward<Args>(args)...);
+  }
+
+  void set(const T& instance) noexcept { std::memcpy(data(), &instance, sizeof(T)); }
+
+  T get() const noexcept {
+    static_assert(hasLayoutOfT(), "WireStorage must have the layout of T.");
+    return bitCast<T>(bytes_);
+  }
+
+  uint8_t* data() noexcept {
+    static_assert(hasLayoutOfT(), "WireStorage must have the layout of T.");
+    return bytes_.data();
+  }
+
+  const uint8_t* data() const noexcept {
+    static_assert(hasLayoutOfT(), "WireStorage must have the layout of T.");
+    return bytes_.data();
+  }
+
+  static constexpr size_t size() noexcept { return sizeof(T); }
+
+ private:
+  // WireStorage is incomplete at class scope, so every accessor checks this instead.
+  static constexpr bool hasLayoutOfT() noexcept {
+    return sizeof(WireStorage) == sizeof(T) && std::is_standard_layout<WireStorage>::value;
+  }
+
+  std::array<uint8_t, sizeof(T)> bytes_;
+};
+
+/**
+ * Encodes a message carrying the stored payload for command C, see encodeMessage().
+ */
+template <typename C, typename P>
+size_t encodeMessage(uint32_t command_id,
+                     const WireStorage<P>& payload,
+                     uint8_t* buffer,
+                     size_t buffer_size) noexcept {
+  return detail::encodeMessage<C, P>(command_id, payload.data(), buffer, buffer_size);
+}
+
+}  // namespace research_interface
@@ -0,0 +1,203 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+
+// Checks that the real-time paths do not allocate once set up.
+//
+// Replaces the global allocation functions with counting versions, runs arena encoding, stream
+// parsing and the command checks in a loop and fails if anything was allocated.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <research_interface/message_arena.h>
+#include <research_interface/message_encoding.h>
+#include <research_interface/robot/cartesian_motion_checker.h>
+#include <research_interface/robot/joint_impedance_controller.h>
+#include <research_interface/robot/joint_motion_checker.h>
+#include <research_interface/robot/message_parser.h>
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/robot_state_validation.h>
+#include <research_interface/robot/service_traits.h>
+#include <research_interface/robot/service_types.h>
+#include <research_interface/robot/torque_rate_limiter.h>
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+}  // anonymous namespace
+
+#if defined(__GLIBC__)
+// Counts in malloc itself, which also catches allocations that bypass operator new.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(pointer, size);
+}
+}
+#endif
+
+namespace {
+
+void* allocate(size_t size) {
+#if !defined(__GLIBC__)
+  allocations.fetch_add(1, std::memory_order_relaxed);
+#endif
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+}  // anonymous namespace
+
+void* operator new(size_t size) {
+  void* pointer = allocate(size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+using namespace research_interface;  // NOLINT(google-build-using-namespace)
+
+constexpr size_t kIterations = 1000;
+constexpr size_t kChunkSize = 61;
+
+template <typename C>
+void append(const typename C::Request& request, std::vector<uint8_t>& stream) {
+  const size_t offset = stream.size();
+  stream.resize(offset + getMessageSize<C, typename C::Request>());
+  encodeMessage<C>(static_cast<uint32_t>(offset), request, stream.data() + offset,
+                   stream.size() - offset);
+}
+
+struct Counter {
+  template <typename Payload>
+  void operator()(const robot::CommandHeader&, const Payload&) {
+    messages++;
+  }
+
+  size_t messages = 0;
+};
+
+bool check(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+  }
+  return condition;
+}
+
+}  // anonymous namespace
+
+int main() {
+  // Setup; everything allocated here is allowed.
+  using Arena = CommandArena<robot::Registry, 4>;
+  Arena arena;
+  const robot::SetCollisionBehavior::Request request({}, {}, {}, {}, {}, {}, {}, {});
+
+  std::vector<uint8_t> stream;
+  append<robot::Connect>(robot::Connect::Request(1338), stream);
+  append<robot::StopMove>(robot::StopMove::Request(), stream);
+  append<robot::SetCollisionBehavior>(request, stream);
+  append<robot::GetCartesianLimit>(robot::GetCartesianLimit::Request(0), stream);
+  robot::RequestParser parser;
+  Counter counter;
+
+  robot::RobotState state{};
+  state.q_d = {{0.0, -0.785, 0.0, -2.356, 0.0, 1.571, 0.785}};
+  state.O_T_EE = {{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0.3, 0, 0.5, 1}};
+  state.O_T_EE_d = state.O_T_EE;
+  state.F_T_EE = state.O_T_EE;
+  state.O_T_EE_c = state.O_T_EE;
+  state.elbow = {{0.0, -1.0}};
+  robot::MotionGeneratorCommand motion{};
+  motion.q_c = state.q_d;
+  motion.O_T_EE_c = state.O_T_EE;
+  const robot::JointMotionChecker joint_checker;
+  const robot::CartesianMotionChecker cartesian_checker;
+  robot::TorqueRateLimiter<> limiter;
+  robot::RobotCommand command{};
+
+  const size_t allocations_before = allocations.load();
+  bool success = true;
+  size_t encoded = 0;
+  for (size_t i = 0; i < kIterations; i++) {
+    uint8_t* slot = arena.acquire();
+    encoded += encodeMessage<robot::SetCollisionBehavior>(static_cast<uint32_t>(i), request, slot,
+                                                          Arena::kSlotSize);
+    arena.release(slot);
+
+    for (size_t offset = 0; offset < stream.size(); offset += kChunkSize) {
+      parser.parse(stream.data() + offset, std::min(kChunkSize, stream.size() - offset), counter);
+    }
+
+    state.motion_generator_mode = robot::MotionGeneratorMode::kJointPosition;
+    success &= joint_checker.check(motion, state).none();
+    state.motion_generator_mode = robot::MotionGeneratorMode::kCartesianPosition;
+    success &= cartesian_checker.check(motion, state).none();
+    success &= robot::validateRobotState(state) == 0;
+    robot::computeJointImpedanceTorques(state, command);
+    limiter.limit(command.control);
+  }
+  const size_t allocated = allocations.load() - allocations_before;
+
+  success = check(success, "checks rejected a valid state or command") &
+            check(encoded == kIterations * getMessageSize<robot::SetCollisionBehavior,
+                                                          robot::SetCollisionBehavior::Request>(),
+                  "not every message was encoded") &
+            check(counter.messages == 4 * kIterations, "not every message was parsed") &
+            check(parser.status() == ParserStatus::kOk, "parser failed");
+  if (!check(allocated == 0, "allocated after setup")) {
+    std::fprintf(stderr, "%zu allocations in %zu iterations\n", allocated, kIterations);
+  }
+  return success && allocated == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,42 @@
+# Compiles codec_codegen.cpp to assembly and checks that every <name>Codec function needs at most
+# as many instructions as <name>ReinterpretCast.
+#
+# Usage: cmake -DCOMPILER=<c++> -DSOURCE=<file> -DINCLUDE_DIR=<dir> -DOUTPUT=<file>
+#              -P check_codegen.cmake
+
+execute_process(
+  COMMAND ${COMPILER} -std=c++14 -O2 -S -I${INCLUDE_DIR} ${SOURCE} -o ${OUTPUT}
+  RESULT_VARIABLE result
+  ERROR_VARIABLE error)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${error}")
+endif()
+
+file(STRINGS ${OUTPUT} lines)
+set(function "")
+foreach(line IN LISTS lines)
+  if(line MATCHES "^_?([A-Za-z]+(ReinterpretCast|Codec)):")
+    set(function ${CMAKE_MATCH_1})
+    set(count_${function} 0)
+  elseif(function AND line MATCHES "^\t\\.cfi_endproc|^\t\\.size|^\t\\.section")
+    set(function "")
+  elseif(function AND line MATCHES "^\t[a-z]")
+    math(EXPR count_${function} "${count_${function}} + 1")
+  endif()
+endforeach()
+
+set(failed FALSE)
+foreach(name headerSize readField decodeRequest decodeState)
+  set(reference ${count_${name}ReinterpretCast})
+  set(codec ${count_${name}Codec})
+  if(NOT reference OR NOT codec)
+    message(FATAL_ERROR "${name}: functions not found in ${OUTPUT}.")
+  endif()
+  message(STATUS "${name}: ${codec} instructions, reinterpret_cast ${reference}")
+  if(codec GREATER reference)
+    set(failed TRUE)
+  endif()
+endforeach()
+if(failed)
+  message(FATAL_ERROR "The codec needs more instructions than reinterpret_cast, see ${OUTPUT}.")
+endif()
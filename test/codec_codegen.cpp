@@ -0,0 +1,64 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+
+// Pairs of functions that decode the same data, once with the strict-aliasing violating
+// reinterpret_cast the codec replaced and once with the codec. check_codegen.cmake compiles this
+// file to assembly and fails if a codec function needs more instructions than its counterpart.
+
+#include <cstdint>
+#include <cstring>
+
+#include <research_interface/codec.h>
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/service_types.h>
+
+using research_interface::bitCast;
+using research_interface::loadField;
+using research_interface::loadUnaligned;
+using research_interface::robot::CommandHeader;
+using research_interface::robot::GetCartesianLimit;
+using research_interface::robot::RobotState;
+using research_interface::robot::SetCollisionBehavior;
+
+extern "C" {
+
+uint32_t headerSizeReinterpretCast(const uint8_t* data) {
+  return reinterpret_cast<const CommandHeader*>(data)->size;
+}
+
+uint32_t headerSizeCodec(const uint8_t* data) {
+  return loadUnaligned<CommandHeader>(data).size;
+}
+
+double readFieldReinterpretCast(const uint8_t* data) {
+  return reinterpret_cast<const GetCartesianLimit::Response*>(data)->object_frame[13];
+}
+
+double readFieldCodec(const uint8_t* data) {
+  using Response = GetCartesianLimit::Response;
+  return loadField<Response>(data, &Response::object_frame)[13];
+}
+
+void decodeRequestReinterpretCast(const uint8_t* data, uint8_t* out) {
+  const SetCollisionBehavior::Request request =
+      *reinterpret_cast<const SetCollisionBehavior::Request*>(data);
+  std::memcpy(out, &request, sizeof(request));
+}
+
+void decodeRequestCodec(const uint8_t* data, uint8_t* out) {
+  const SetCollisionBehavior::Request request =
+      loadUnaligned<SetCollisionBehavior::Request>(data);
+  std::memcpy(out, &request, sizeof(request));
+}
+
+void decodeStateReinterpretCast(const uint8_t* data, uint8_t* out) {
+  const RobotState state = *reinterpret_cast<const RobotState*>(data);
+  std::memcpy(out, &state, sizeof(state));
+}
+
+void decodeStateCodec(const uint8_t* data, uint8_t* out) {
+  const RobotState state = loadUnaligned<RobotState>(data);
+  std::memcpy(out, &state, sizeof(state));
+}
+
+}  // extern "C"
@@ -0,0 +1,504 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+
+// Loopback simulator for the robot command protocol.
+//
+// Accepts one client at a time on the command port, answers all commands of
+// research_interface::robot and streams RobotState over UDP at a configurable rate while
+// consuming RobotCommand. Joint position and velocity commands are applied to the simulated
+// joint state, so a client sees its own motion reflected in q and dq.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <research_interface/robot/rbk_types.h>
+#include <research_interface/robot/service_traits.h>
+#include <research_interface/robot/service_types.h>
+
+namespace {
+
+using namespace research_interface::robot;  // NOLINT(google-build-using-namespace)
+
+constexpr int64_t kNanosecondsPerSecond = 1000000000;
+constexpr double kSuccessRateWindow = 100.0;
+
+struct Options {
+  uint16_t port = kCommandPort;
+  double rate = 1000.0;
+};
+
+int64_t now() {
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * kNanosecondsPerSecond + time.tv_nsec;
+}
+
+void check(bool success, const char* what) {
+  if (!success) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+}
+
+class Simulator {
+ public:
+  explicit Simulator(const Options& options)
+      : period_(static_cast<int64_t>(kNanosecondsPerSecond / options.rate)) {
+    listen_socket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    check(listen_socket_ != -1, "socket");
+    const int enable = 1;
+    ::setsockopt(listen_socket_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(options.port);
+    check(::bind(listen_socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0,
+          "bind");
+    check(::listen(listen_socket_, 1) == 0, "listen");
+
+    udp_socket_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    check(udp_socket_ != -1, "socket");
+
+    resetState();
+  }
+
+  ~Simulator() {
+    closeClient();
+    ::close(udp_socket_);
+    ::close(listen_socket_);
+  }
+
+  void run() {
+    int64_t next_tick = now();
+    while (true) {
+      pollfd fds[2] = {{client_socket_ == -1 ? listen_socket_ : client_socket_, POLLIN, 0},
+                       {udp_socket_, POLLIN, 0}};
+      const int64_t timeout = std::max<int64_t>(next_tick - now(), 0);
+      const timespec timeout_spec{static_cast<time_t>(timeout / kNanosecondsPerSecond),
+                                  static_cast<long>(timeout % kNanosecondsPerSecond)};
+      const int result = ::ppoll(fds, 2, &timeout_spec, nullptr);
+      if (result == -1 && errno != EINTR) {
+        check(false, "ppoll");
+      }
+      if ((fds[0].revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+        client_socket_ == -1 ? acceptClient() : receiveCommands();
+      }
+      if ((fds[1].revents & POLLIN) != 0) {
+        receiveRobotCommands();
+      }
+      if (now() >= next_tick) {
+        tick();
+        next_tick += period_;
+      }
+    }
+  }
+
+ private:
+  void resetState() {
+    state_ = RobotState{};
+    state_.robot_mode = RobotMode::kIdle;
+    state_.motion_generator_mode = MotionGeneratorMode::kIdle;
+    state_.controller_mode = ControllerMode::kJointImpedance;
+    for (std::array<double, 16>* transform : {&state_.O_T_EE, &state_.O_T_EE_d, &state_.F_T_EE,
+                                              &state_.EE_T_K, &state_.F_T_NE, &state_.NE_T_EE,
+                                              &state_.O_T_EE_c}) {
+      *transform = {{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}};
+    }
+    state_.q = {{0, -0.785398, 0, -2.356194, 0, 1.570796, 0.785398}};
+    state_.q_d = state_.q;
+    state_.theta = state_.q;
+  }
+
+  void acceptClient() {
+    client_socket_ = ::accept(listen_socket_, nullptr, nullptr);
+    check(client_socket_ != -1, "accept");
+    const int enable = 1;
+    ::setsockopt(client_socket_, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    receive_buffer_.clear();
+    std::printf("Client connected.\n");
+  }
+
+  void closeClient() {
+    if (client_socket_ != -1) {
+      ::close(client_socket_);
+      client_socket_ = -1;
+      udp_connected_ = false;
+      connected_ = false;
+      move_command_id_ = 0;
+      moving_ = false;
+      resetState();
+      std::printf("Client disconnected.\n");
+    }
+  }
+
+  void receiveCommands() {
+    uint8_t buffer[4096];
+    const ssize_t size = ::recv(client_socket_, buffer, sizeof(buffer), 0);
+    if (size <= 0) {
+      closeClient();
+      return;
+    }
+    receive_buffer_.insert(receive_buffer_.end(), buffer, buffer + size);
+
+    while (receive_buffer_.size() >= sizeof(CommandHeader)) {
+      CommandHeader header;
+      std::memcpy(&header, receive_buffer_.data(), sizeof(header));
+      // Bounds the receive buffer: no request is larger than kMaxRequestSize.
+      if (header.size < sizeof(CommandHeader) || header.size > Registry::kMaxRequestSize) {
+        std::fprintf(stderr, "Invalid message size %u, dropping client.\n", header.size);
+        closeClient();
+        return;
+      }
+      if (receive_buffer_.size() < header.size) {
+        return;
+      }
+      handleCommand(header);
+      if (client_socket_ == -1) {
+        return;
+      }
+      receive_buffer_.erase(receive_buffer_.begin(), receive_buffer_.begin() + header.size);
+    }
+  }
+
+  template <typename T>
+  typename T::Request decode() const {
+    CommandMessage<typename T::Request> message;
+    std::memcpy(&message, receive_buffer_.data(), sizeof(message));
+    return message.getInstance();
+  }
+
+  template <typename T>
+  bool hasSize(const CommandHeader& header) const {
+    return header.size == sizeof(CommandMessage<typename T::Request>);
+  }
+
+  template <typename T>
+  void respond(uint32_t command_id, const typename T::Response& response) {
+    const CommandMessage<typename T::Response> message(
+        CommandHeader(T::kCommand, command_id, sizeof(CommandMessage<typename T::Response>)),
+        response);
+    if (::send(client_socket_, &message, sizeof(message), MSG_NOSIGNAL) !=
+        static_cast<ssize_t>(sizeof(message))) {
+      closeClient();
+    }
+  }
+
+  template <typename T>
+  void respond(uint32_t command_id, typename T::Status status) {
+    respond<T>(command_id, typename T::Response(status));
+  }
+
+  template <typename T>
+  void handleSetter(const CommandHeader& header) {
+    respond<T>(header.command_id,
+               hasSize<T>(header) ? T::Status::kSuccess : T::Status::kInvalidArgumentRejected);
+  }
+
+  void handleCommand(const CommandHeader& header) {
+    if (!connected_ && header.command != Command::kConnect) {
+      std::fprintf(stderr, "Received command %u before Connect, dropping client.\n",
+                   static_cast<uint32_t>(header.command));
+      closeClient();
+      return;
+    }
+    switch (header.command) {
+      case Command::kConnect:
+        handleConnect(header);
+        break;
+      case Command::kMove:
+        handleMove(header);
+        break;
+      case Command::kStopMove:
+        handleStopMove(header);
+        break;
+      case Command::kGetCartesianLimit:
+        respond<GetCartesianLimit>(header.command_id, GetCartesianLimit::Status::kSuccess);
+        break;
+      case Command::kSetCollisionBehavior:
+        handleSetter<SetCollisionBehavior>(header);
+        break;
+      case Command::kSetJointImpedance:
+        handleSetter<SetJointImpedance>(header);
+        break;
+      case Command::kSetCartesianImpedance:
+        handleSetter<SetCartesianImpedance>(header);
+        break;
+      case Command::kSetGuidingMode:
+        handleSetter<SetGuidingMode>(header);
+        break;
+      case Command::kSetEEToK:
+        if (hasSize<SetEEToK>(header)) {
+          state_.EE_T_K = decode<SetEEToK>().EE_T_K;
+        }
+        handleSetter<SetEEToK>(header);
+        break;
+      case Command::kSetNEToEE:
+        if (hasSize<SetNEToEE>(header)) {
+          state_.NE_T_EE = decode<SetNEToEE>().NE_T_EE;
+        }
+        handleSetter<SetNEToEE>(header);
+        break;
+      case Command::kSetLoad:
+        if (hasSize<SetLoad>(header)) {
+          const SetLoad::Request request = decode<SetLoad>();
+          state_.m_load = request.m_load;
+          state_.F_x_Cload = request.F_x_Cload;
+          state_.I_load = request.I_load;
+        }
+        handleSetter<SetLoad>(header);
+        break;
+      case Command::kSetFilters:
+        handleSetter<SetFilters>(header);
+        break;
+      case Command::kAutomaticErrorRecovery:
+        handleAutomaticErrorRecovery(header);
+        break;
+      case Command::kLoadModelLibrary:
+        // The simulator does not ship a model library.
+        respond<LoadModelLibrary>(header.command_id, LoadModelLibrary::Status::kError);
+        break;
+      default:
+        std::fprintf(stderr, "Unknown command %u, dropping client.\n",
+                     static_cast<uint32_t>(header.command));
+        closeClient();
+    }
+  }
+
+  void handleConnect(const CommandHeader& header) {
+    if (!hasSize<Connect>(header)) {
+      respond<Connect>(header.command_id, Connect::Status::kIncompatibleLibraryVersion);
+      return;
+    }
+    const Connect::Request request = decode<Connect>();
+    if (request.version != kVersion) {
+      respond<Connect>(header.command_id, Connect::Status::kIncompatibleLibraryVersion);
+      return;
+    }
+
+    sockaddr_in address{};
+    socklen_t address_size = sizeof(address);
+    check(::getpeername(client_socket_, reinterpret_cast<sockaddr*>(&address), &address_size) == 0,
+          "getpeername");
+    address.sin_port = htons(request.udp_port);
+    check(::connect(udp_socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0,
+          "connect");
+    udp_connected_ = true;
+    connected_ = true;
+    respond<Connect>(header.command_id, Connect::Status::kSuccess);
+  }
+
+  void handleMove(const CommandHeader& header) {
+    if (!hasSize<Move>(header)) {
+      respond<Move>(header.command_id, Move::Status::kInvalidArgumentRejected);
+      return;
+    }
+    if (moving_ || state_.robot_mode != RobotMode::kIdle) {
+      respond<Move>(header.command_id, Move::Status::kCommandNotPossibleRejected);
+      return;
+    }
+    const Move::Request request = decode<Move>();
+    switch (request.motion_generator_mode) {
+      case Move::MotionGeneratorMode::kJointPosition:
+        state_.motion_generator_mode = MotionGeneratorMode::kJointPosition;
+        break;
+      case Move::MotionGeneratorMode::kJointVelocity:
+        state_.motion_generator_mode = MotionGeneratorMode::kJointVelocity;
+        break;
+      case Move::MotionGeneratorMode::kCartesianPosition:
+        state_.motion_generator_mode = MotionGeneratorMode::kCartesianPosition;
+        break;
+      case Move::MotionGeneratorMode::kCartesianVelocity:
+        state_.motion_generator_mode = MotionGeneratorMode::kCartesianVelocity;
+        break;
+      default:
+        respond<Move>(header.command_id, Move::Status::kInvalidArgumentRejected);
+        return;
+    }
+    switch (request.controller_mode) {
+      case Move::ControllerMode::kJointImpedance:
+        state_.controller_mode = ControllerMode::kJointImpedance;
+        break;
+      case Move::ControllerMode::kCartesianImpedance:
+        state_.controller_mode = ControllerMode::kCartesianImpedance;
+        break;
+      case Move::ControllerMode::kExternalController:
+        state_.controller_mode = ControllerMode::kExternalController;
+        break;
+      default:
+        state_.motion_generator_mode = MotionGeneratorMode::kIdle;
+        respond<Move>(header.command_id, Move::Status::kInvalidArgumentRejected);
+        return;
+    }
+    state_.robot_mode = RobotMode::kMove;
+    moving_ = true;
+    move_command_id_ = header.command_id;
+    respond<Move>(header.command_id, Move::Status::kMotionStarted);
+  }
+
+  void finishMove(Move::Status status) {
+    state_.robot_mode = RobotMode::kIdle;
+    state_.motion_generator_mode = MotionGeneratorMode::kIdle;
+    state_.dq = {};
+    moving_ = false;
+    respond<Move>(move_command_id_, status);
+  }
+
+  void handleStopMove(const CommandHeader& header) {
+    if (moving_) {
+      finishMove(Move::Status::kPreempted);
+    }
+    if (client_socket_ != -1) {
+      respond<StopMove>(header.command_id, StopMove::Status::kSuccess);
+    }
+  }
+
+  void handleAutomaticErrorRecovery(const CommandHeader& header) {
+    if (moving_) {
+      respond<AutomaticErrorRecovery>(header.command_id,
+                                      AutomaticErrorRecovery::Status::kCommandNotPossibleRejected);
+      return;
+    }
+    state_.errors = {};
+    state_.reflex_reason = {};
+    state_.robot_mode = RobotMode::kIdle;
+    respond<AutomaticErrorRecovery>(header.command_id, AutomaticErrorRecovery::Status::kSuccess);
+  }
+
+  void receiveRobotCommands() {
+    RobotCommand command;
+    while (::recv(udp_socket_, &command, sizeof(command), MSG_DONTWAIT) ==
+           static_cast<ssize_t>(sizeof(command))) {
+      if (command.message_id == state_.message_id) {
+        commands_answered_++;
+      }
+      last_command_ = command;
+      has_command_ = true;
+    }
+  }
+
+  void applyCommand() {
+    const double dt = static_cast<double>(period_) / kNanosecondsPerSecond;
+    const MotionGeneratorCommand& motion = last_command_.motion;
+    switch (state_.motion_generator_mode) {
+      case MotionGeneratorMode::kJointPosition:
+        for (size_t i = 0; i < state_.q.size(); i++) {
+          state_.dq[i] = (motion.q_c[i] - state_.q[i]) / dt;
+        }
+        state_.q = motion.q_c;
+        break;
+      case MotionGeneratorMode::kJointVelocity:
+        for (size_t i = 0; i < state_.q.size(); i++) {
+          state_.q[i] += motion.dq_c[i] * dt;
+        }
+        state_.dq = motion.dq_c;
+        break;
+      case MotionGeneratorMode::kCartesianPosition:
+        state_.O_T_EE = motion.O_T_EE_c;
+        break;
+      case MotionGeneratorMode::kCartesianVelocity:
+        for (size_t i = 0; i < 3; i++) {
+          state_.O_T_EE[12 + i] += motion.O_dP_EE_c[i] * dt;
+        }
+        break;
+      default:
+        break;
+    }
+    state_.q_d = state_.q;
+    state_.dq_d = state_.dq;
+    state_.theta = state_.q;
+    state_.dtheta = state_.dq;
+    state_.O_T_EE_d = state_.O_T_EE;
+    state_.O_T_EE_c = motion.O_T_EE_c;
+    state_.O_dP_EE_c = motion.O_dP_EE_c;
+    state_.elbow_c = motion.elbow_c;
+    state_.tau_J_d = last_command_.control.tau_J_d;
+    if (motion.motion_generation_finished) {
+      finishMove(Move::Status::kSuccess);
+    }
+  }
+
+  void tick() {
+    if (moving_ && has_command_) {
+      applyCommand();
+    }
+    has_command_ = false;
+
+    // Exponential moving average over roughly kSuccessRateWindow cycles.
+    const double answered = commands_answered_ > 0 ? 1.0 : 0.0;
+    state_.control_command_success_rate +=
+        (answered - state_.control_command_success_rate) / kSuccessRateWindow;
+    commands_answered_ = 0;
+
+    if (udp_connected_) {
+      state_.message_id++;
+      ::send(udp_socket_, &state_, sizeof(state_), MSG_DONTWAIT);
+    }
+  }
+
+  const int64_t period_;
+  int listen_socket_ = -1;
+  int client_socket_ = -1;
+  int udp_socket_ = -1;
+  bool connected_ = false;
+  bool udp_connected_ = false;
+  bool moving_ = false;
+  bool has_command_ = false;
+  uint32_t move_command_id_ = 0;
+  uint64_t commands_answered_ = 0;
+  std::vector<uint8_t> receive_buffer_;
+  RobotState state_;
+  RobotCommand last_command_{};
+};
+
+void printUsage(const char* name) {
+  std::fprintf(stderr, "Usage: %s [--port <port>] [--rate <Hz>]\n", name);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+    if (argument == "--port" && i + 1 < argc) {
+      options.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+    } else if (argument == "--rate" && i + 1 < argc) {
+      options.rate = std::atof(argv[++i]);
+    } else {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (options.rate < 1.0 || options.rate > 10000.0) {
+    std::fprintf(stderr, "Rate must be between 1 and 10000 Hz.\n");
+    return EXIT_FAILURE;
+  }
+
+  try {
+    Simulator simulator(options);
+    std::printf("Simulating robot on port %u, streaming robot states at %.0f Hz.\n", options.port,
+                options.rate);
+    simulator.run();
+  } catch (const std::exception& exception) {
+    std::fprintf(stderr, "%s\n", exception.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,340 @@
+// Copyright (c) 2017 Franka Emika GmbH
+// Use of this source code is governed by the Apache-2.0 license, see LICENSE
+
+// Load generator emulating many robots streaming RobotState to a fleet controller.
+//
+// Virtual robot i sends RobotState datagrams to <target>:<base-port + i> at the given rate, with a
+// monotonically increasing message_id. States are either replayed from a recording (a file of
+// raw RobotState structs) or synthesized. All robots share one UDP socket, so a single sendmmsg
+// call per cycle sends the states of all robots. RobotCommand replies are matched to the robot by
+// their source port and to the state by message_id. A reply counts as on time if it arrives
+// within one period.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <research_interface/robot/rbk_types.h>
+
+namespace {
+
+using research_interface::robot::RobotCommand;
+using research_interface::robot::RobotState;
+
+constexpr int64_t kNanosecondsPerSecond = 1000000000;
+constexpr size_t kPendingStates = 64;
+constexpr size_t kReceiveBatch = 64;
+constexpr int64_t kNotPending = -1;
+// Highest accepted rate; the period has to stay well above the clock resolution.
+constexpr double kMaxRate = 100000.0;
+// Robot i starts replaying the recording at state i * kReplayStride, so that robots do not send
+// identical states. A prime keeps the starts apart for most recording lengths.
+constexpr size_t kReplayStride = 97;
+
+struct Options {
+  std::string target = "127.0.0.1";
+  uint16_t base_port = 20000;
+  size_t robots = 1;
+  double rate = 1000.0;
+  double duration = 10.0;
+  std::string recording;
+};
+
+int64_t now() {
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * kNanosecondsPerSecond + time.tv_nsec;
+}
+
+void check(bool success, const char* what) {
+  if (!success) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+}
+
+struct StreamStatistics {
+  uint64_t sent = 0;
+  uint64_t on_time = 0;
+  uint64_t late = 0;
+  uint64_t dropped = 0;
+  uint64_t unmatched = 0;
+  double latency_sum = 0.0;
+  double latency_square_sum = 0.0;
+  double latency_max = 0.0;
+};
+
+class VirtualRobot {
+ public:
+  VirtualRobot(const sockaddr_in& address, const std::vector<RobotState>& recording, size_t offset)
+      : address_(address), recording_(recording), replay_index_(offset) {
+    pending_.fill(kNotPending);
+  }
+
+  const sockaddr_in& address() const noexcept { return address_; }
+
+  const RobotState& nextState(int64_t time, double phase) {
+    if (recording_.empty()) {
+      for (size_t i = 0; i < state_.q.size(); i++) {
+        state_.q[i] = 0.5 * std::sin(phase + static_cast<double>(i));
+        state_.dq[i] = 0.5 * std::cos(phase + static_cast<double>(i));
+      }
+    } else {
+      state_ = recording_[replay_index_++ % recording_.size()];
+    }
+    state_.message_id = ++message_id_;
+
+    int64_t& slot = pending_[message_id_ % kPendingStates];
+    if (slot != kNotPending) {
+      statistics_.dropped++;
+    }
+    slot = time;
+    statistics_.sent++;
+    return state_;
+  }
+
+  void receive(const RobotCommand& command, int64_t time, int64_t period) {
+    const uint64_t id = command.message_id;
+    int64_t& slot = pending_[id % kPendingStates];
+    if (id > message_id_ || message_id_ - id >= kPendingStates || slot == kNotPending) {
+      statistics_.unmatched++;
+      return;
+    }
+    const int64_t latency = time - slot;
+    slot = kNotPending;
+    (latency <= period ? statistics_.on_time : statistics_.late)++;
+    const double latency_us = static_cast<double>(latency) / 1e3;
+    statistics_.latency_sum += latency_us;
+    statistics_.latency_square_sum += latency_us * latency_us;
+    statistics_.latency_max = std::max(statistics_.latency_max, latency_us);
+  }
+
+  StreamStatistics finish() {
+    for (int64_t& slot : pending_) {
+      if (slot != kNotPending) {
+        statistics_.dropped++;
+        slot = kNotPending;
+      }
+    }
+    return statistics_;
+  }
+
+ private:
+  sockaddr_in address_;
+  const std::vector<RobotState>& recording_;
+  size_t replay_index_;
+  RobotState state_{};
+  uint64_t message_id_ = 0;
+  std::array<int64_t, kPendingStates> pending_;
+  StreamStatistics statistics_;
+};
+
+std::vector<RobotState> loadRecording(const std::string& path) {
+  std::vector<RobotState> recording;
+  if (path.empty()) {
+    return recording;
+  }
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Could not open recording " + path);
+  }
+  RobotState state;
+  while (file.read(reinterpret_cast<char*>(&state), sizeof(state))) {
+    recording.push_back(state);
+  }
+  if (recording.empty()) {
+    throw std::runtime_error("Recording " + path + " does not contain a complete RobotState.");
+  }
+  return recording;
+}
+
+void run(const Options& options) {
+  const std::vector<RobotState> recording = loadRecording(options.recording);
+  const int64_t period = static_cast<int64_t>(kNanosecondsPerSecond / options.rate);
+
+  const int udp_socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+  check(udp_socket != -1, "socket");
+  const int buffer_size = static_cast<int>(options.robots * sizeof(RobotState) * 4);
+  ::setsockopt(udp_socket, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+  ::setsockopt(udp_socket, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+
+  std::vector<VirtualRobot> robots;
+  robots.reserve(options.robots);
+  for (size_t i = 0; i < options.robots; i++) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(options.base_port + i));
+    if (::inet_pton(AF_INET, options.target.c_str(), &address.sin_addr) != 1) {
+      throw std::runtime_error("Invalid target address " + options.target);
+    }
+    robots.emplace_back(address, recording, i * kReplayStride);
+  }
+
+  std::vector<iovec> send_vectors(options.robots);
+  std::vector<mmsghdr> send_messages(options.robots);
+
+  std::array<RobotCommand, kReceiveBatch> commands;
+  std::array<iovec, kReceiveBatch> receive_vectors;
+  std::array<sockaddr_in, kReceiveBatch> sources;
+  std::array<mmsghdr, kReceiveBatch> receive_messages;
+
+  const int64_t start = now();
+  const int64_t end = start + static_cast<int64_t>(options.duration * kNanosecondsPerSecond);
+  int64_t next_tick = start;
+  uint64_t send_failures = 0;
+  double send_jitter_max = 0.0;
+
+  while (next_tick < end) {
+    timespec wakeup{static_cast<time_t>(next_tick / kNanosecondsPerSecond),
+                    static_cast<long>(next_tick % kNanosecondsPerSecond)};
+    ::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup, nullptr);
+
+    const int64_t send_time = now();
+    send_jitter_max = std::max(send_jitter_max, static_cast<double>(send_time - next_tick) / 1e3);
+    const double phase = static_cast<double>(send_time - start) / kNanosecondsPerSecond;
+    for (size_t i = 0; i < robots.size(); i++) {
+      const RobotState& state = robots[i].nextState(send_time, phase);
+      send_vectors[i] = {const_cast<RobotState*>(&state), sizeof(state)};
+      send_messages[i] = {};
+      send_messages[i].msg_hdr.msg_name = const_cast<sockaddr_in*>(&robots[i].address());
+      send_messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      send_messages[i].msg_hdr.msg_iov = &send_vectors[i];
+      send_messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    for (size_t sent = 0; sent < send_messages.size();) {
+      const int result = ::sendmmsg(udp_socket, &send_messages[sent],
+                                    static_cast<unsigned int>(send_messages.size() - sent), 0);
+      if (result <= 0) {
+        send_failures += send_messages.size() - sent;
+        break;
+      }
+      sent += static_cast<size_t>(result);
+    }
+
+    next_tick += period;
+    while (true) {
+      const int64_t timeout = next_tick - now();
+      if (timeout <= 0) {
+        break;
+      }
+      pollfd fd{udp_socket, POLLIN, 0};
+      const timespec timeout_spec{static_cast<time_t>(timeout / kNanosecondsPerSecond),
+                                  static_cast<long>(timeout % kNanosecondsPerSecond)};
+      if (::ppoll(&fd, 1, &timeout_spec, nullptr) <= 0) {
+        continue;
+      }
+      for (size_t i = 0; i < kReceiveBatch; i++) {
+        receive_vectors[i] = {&commands[i], sizeof(RobotCommand)};
+        receive_messages[i] = {};
+        receive_messages[i].msg_hdr.msg_name = &sources[i];
+        receive_messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        receive_messages[i].msg_hdr.msg_iov = &receive_vectors[i];
+        receive_messages[i].msg_hdr.msg_iovlen = 1;
+      }
+      const int received = ::recvmmsg(udp_socket, receive_messages.data(), kReceiveBatch,
+                                      MSG_DONTWAIT, nullptr);
+      const int64_t receive_time = now();
+      for (int i = 0; i < received; i++) {
+        const size_t robot = static_cast<size_t>(ntohs(sources[i].sin_port) - options.base_port);
+        if (receive_messages[i].msg_len == sizeof(RobotCommand) && robot < robots.size()) {
+          robots[robot].receive(commands[i], receive_time, period);
+        }
+      }
+    }
+  }
+  ::close(udp_socket);
+
+  std::printf("%8s %10s %10s %10s %10s %10s %12s %12s %12s\n", "robot", "sent", "on_time",
+              "late", "dropped", "unmatched", "latency_us", "jitter_us", "max_us");
+  StreamStatistics total;
+  for (size_t i = 0; i < robots.size(); i++) {
+    const StreamStatistics statistics = robots[i].finish();
+    const uint64_t replies = statistics.on_time + statistics.late;
+    const double mean = replies > 0 ? statistics.latency_sum / replies : 0.0;
+    const double variance =
+        replies > 0 ? statistics.latency_square_sum / replies - mean * mean : 0.0;
+    std::printf("%8zu %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64
+                " %12.1f %12.1f %12.1f\n",
+                i, statistics.sent, statistics.on_time, statistics.late, statistics.dropped,
+                statistics.unmatched, mean, std::sqrt(std::max(variance, 0.0)),
+                statistics.latency_max);
+    total.sent += statistics.sent;
+    total.on_time += statistics.on_time;
+    total.late += statistics.late;
+    total.dropped += statistics.dropped;
+    total.unmatched += statistics.unmatched;
+  }
+  std::printf("total: %" PRIu64 " sent, %" PRIu64 " on time (%.3f%%), %" PRIu64 " late, %" PRIu64
+              " dropped, %" PRIu64 " unmatched, %" PRIu64
+              " send failures, max send jitter %.1f us\n",
+              total.sent, total.on_time,
+              total.sent > 0 ? 100.0 * total.on_time / total.sent : 0.0, total.late,
+              total.dropped, total.unmatched, send_failures, send_jitter_max);
+}
+
+void printUsage(const char* name) {
+  std::fprintf(stderr,
+               "Usage: %s [--target <ip>] [--base-port <port>] [--robots <N>] [--rate <Hz>]\n"
+               "          [--duration <s>] [--recording <file>]\n",
+               name);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+    if (i + 1 >= argc) {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    if (argument == "--target") {
+      options.target = argv[++i];
+    } else if (argument == "--base-port") {
+      options.base_port = static_cast<uint16_t>(std::atoi(argv[++i]));
+    } else if (argument == "--robots") {
+      options.robots = static_cast<size_t>(std::atol(argv[++i]));
+    } else if (argument == "--rate") {
+      options.rate = std::atof(argv[++i]);
+    } else if (argument == "--duration") {
+      options.duration = std::atof(argv[++i]);
+    } else if (argument == "--recording") {
+      options.recording = argv[++i];
+    } else {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (options.robots == 0 || options.base_port + options.robots > 65536 ||
+      !(options.rate > 0.0 && options.rate <= kMaxRate)) {
+    std::fprintf(stderr, "Invalid number of robots, base port or rate (at most %.0f Hz).\n",
+                 kMaxRate);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    run(options);
+  } catch (const std::exception& exception) {
+    std::fprintf(stderr, "%s\n", exception.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}